@@ -1 +1,34 @@
- 
\ No newline at end of file
+#ifndef __L3GD20_H
+#define __L3GD20_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stm32f3xx_hal.h"
+
+#define L3GD20_DPS_PER_LSB  0.00875f    // ±250 dps hassasiyeti
+
+/* L3GD20 Gyroscope Data Structure */
+typedef struct {
+    float x;            // X ekseni açısal hız (dps)
+    float y;            // Y ekseni açısal hız (dps)
+    float z;            // Z ekseni açısal hız (dps)
+    float magnitude;    // √(x² + y² + z²)
+    uint32_t mag2;      // x² + y² + z², ham LSB² - motor eğrisi indeksi (karekök yok)
+    uint32_t timestamp; // Okuma anı (DWT cycle) - gerçek dt için
+} L3GD20_Data_t;
+
+/* Function Prototypes */
+void L3GD20_Init(void);
+void L3GD20_ReadData(L3GD20_Data_t* data);
+uint8_t L3GD20_ReadRegister(uint8_t reg);
+void L3GD20_WriteRegister(uint8_t reg, uint8_t value);
+uint8_t L3GD20_CalculateMotorSpeed(L3GD20_Data_t* gyro_data);
+void L3GD20_DisplayOnTerminal(L3GD20_Data_t* gyro_data, uint8_t motor_speed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __L3GD20_H */
\ No newline at end of file
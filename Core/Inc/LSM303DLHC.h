@@ -25,8 +25,14 @@ typedef struct
     float z_g;       // z-axis value in g
 } LSM303DLHC_t;
 
+/* Son okunan ivme değerleri (g) - LSM303DLHC_ReadAccel() günceller */
+extern volatile float accel_x;
+extern volatile float accel_y;
+extern volatile float accel_z;
+
 /* Function Prototypes */
 HAL_StatusTypeDef LSM303DLHC_Init(void);
+HAL_StatusTypeDef LSM303DLHC_ReadAccel(void);
 void LSM303DLHC_Read_All(LSM303DLHC_t *DataStruct);
 uint8_t CalculateMotorSpeed(LSM303DLHC_t *accel);
 void SendDebugMessage(const char* msg);
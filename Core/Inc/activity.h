@@ -0,0 +1,75 @@
+#ifndef __ACTIVITY_H__
+#define __ACTIVITY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Aktivite sınıflandırıcı - pencere özellikleri üzerinde karar ağacı
+ * Özellikler örnek başına artımlı toplanır; pencere sonunda ağaç değerlendirilir
+ * ve sadece etiket değişimi UART'a yazılır. Ağaç ve eşikler bir config blob'undan
+ * yüklenebilir (ACFG komutu).
+ * İvme özelliği |a|'nın pencere içi standart sapmasıdır - ortalama (1g ve
+ * ivmeölçer ölçek hatası) çıkarılır. İvme okunamayan örnekler bu özelliğe
+ * girmez; pencerede hiç ivme yoksa özellik geçersizdir ve onu test eden
+ * düğüm sol (eşik altı) dala gider - karar sadece gyro özelliklerine kalır. */
+
+#define ACTIVITY_MAX_NODES      16
+#define ACTIVITY_BLOB_MAGIC     "ACT1"
+#define ACTIVITY_BLOB_HEADER    8       // magic(4) + node_count + min_windows + window_ms(2)
+#define ACTIVITY_BLOB_NODE      8       // feature, left, right, pad, threshold(float LE)
+#define ACTIVITY_BLOB_MAX       (ACTIVITY_BLOB_HEADER + ACTIVITY_MAX_NODES * ACTIVITY_BLOB_NODE + 2)
+#define ACTIVITY_ZC_HYST_DPS    1.0f    // Sıfır geçişi histerezisi
+#define ACTIVITY_MIN_PEAK_DPS   0.2f    // Bu genliğin altındaki FFT tepesi "baskın" sayılmaz
+
+typedef enum {
+    ACTIVITY_IDLE = 0,
+    ACTIVITY_HANDLING,
+    ACTIVITY_TRANSPORT,
+    ACTIVITY_VIBRATION,
+    ACTIVITY_LABEL_COUNT
+} Activity_Label_t;
+
+typedef enum {
+    ACTIVITY_FEAT_GYRO_RMS = 0,     // dps
+    ACTIVITY_FEAT_ACC_RMS,          // |a| standart sapması (g)
+    ACTIVITY_FEAT_ZC_RATE,          // Sıfır geçişi / s (tüm eksenler)
+    ACTIVITY_FEAT_DOM_FREQ,         // Baskın frekans (Hz, spektrumdan)
+    ACTIVITY_FEAT_DOM_BAND,         // Baskın bant indeksi
+    ACTIVITY_FEAT_COUNT
+} Activity_Feature_t;
+
+/* Ağaç düğümü: feature < threshold ise left, değilse right.
+ * Çocuk < 0 ise yaprak: etiket = -(child + 1) */
+typedef struct {
+    uint8_t feature;
+    int8_t left;
+    int8_t right;
+    float threshold;
+} Activity_Node_t;
+
+typedef struct {
+    uint8_t node_count;
+    uint8_t min_windows;    // Etiket değişimi için ardışık pencere sayısı
+    uint16_t window_ms;
+    Activity_Node_t nodes[ACTIVITY_MAX_NODES];
+} Activity_Config_t;
+
+#define ACTIVITY_LEAF(label)    ((int8_t)(-(int8_t)(label) - 1))
+
+void Activity_Init(void);
+void Activity_Update(const L3GD20_Data_t* gyro, const float acc[3], uint8_t acc_ok, uint32_t now_ms);
+HAL_StatusTypeDef Activity_LoadConfig(const uint8_t* blob, uint16_t len);
+Activity_Label_t Activity_GetLabel(void);
+const char* Activity_Name(Activity_Label_t label);
+void Activity_ReportFeatures(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ACTIVITY_H__ */
@@ -0,0 +1,33 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ADC_H__
+#define __ADC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+extern DMA_HandleTypeDef hdma_adc1;
+
+/* USER CODE BEGIN Private defines */
+#define ADC1_SENSE_CHANNEL      2U      // PA1 - ADC1_IN2, motor akım algılama
+#define ADC1_EXTSEL_TIM3_CC4    15U     // ADC12 EXT15: TIM3_CC4 (RM0316 düzenli grup tetik tablosu)
+/* USER CODE END Private defines */
+
+void MX_ADC1_Init(uint16_t* buffer, uint16_t length);
+
+/* USER CODE BEGIN Prototypes */
+
+/* USER CODE END Prototypes */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ADC_H__ */
@@ -0,0 +1,41 @@
+#ifndef __ANGLE_H__
+#define __ANGLE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Bias düzeltilmiş hızların açıya entegrasyonu
+ * dt her örnekte donanım zaman damgasından (DWT) hesaplanır, nominal periyot kullanılmaz. */
+
+#define ANGLE_DT_MAX_S   0.5f   // Bundan uzun boşluk entegre edilmez (ör. debugger durdurması)
+
+typedef struct {
+    float angle[3];         // Toplam açı (derece) - X, Y, Z
+    float still_angle[3];   // Hareketsizken biriken açı (drift tahmini için)
+    float still_time_s;     // Toplam hareketsiz süre
+    float elapsed_s;        // Son reset'ten beri geçen süre
+    float last_rate[3];     // Trapez entegrasyonu için önceki hız
+    uint32_t last_ts;       // Önceki örneğin zaman damgası (cycle)
+    float dt_min_s;         // Rapor periyodundaki en küçük/büyük dt
+    float dt_max_s;
+    uint32_t gaps;          // ANGLE_DT_MAX_S üstü atlanan boşluklar
+    uint8_t has_last;
+} Angle_t;
+
+extern Angle_t angle_state;
+
+void Angle_Reset(void);
+void Angle_Update(const L3GD20_Data_t* data, uint8_t still);
+void Angle_GetDriftPerMinute(float drift[3]);
+void Angle_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ANGLE_H__ */
@@ -0,0 +1,98 @@
+#ifndef __COMMAND_H__
+#define __COMMAND_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+#define CMD_LINE_SIZE    64      // En uzun komut satırı (sonlandırıcı dahil) - uzunu bütün atılır
+#define CMD_QUEUE_DEPTH  4       // İşlenmeyi bekleyen tam satır (2'nin kuvveti)
+
+/* UART Komutları - satır sonu '\r' veya '\n' ile biter
+ * Alım dairesel DMA ile rxBuffer'a; HT/TC ve hat boşta (IDLE) kesmeleri
+ * gelen byte'ları satırlara ayırıp kuyruğa koyar, ana döngü hepsini işler
+ *   Dxx    : PWM duty (%)
+ *   DF x   : Hassas duty, x = -10000..10000 (0.01% adım, x<0 geri yön)
+ *   ARST   : Açı entegrasyonunu sıfırla
+ *   BRST   : Gyro bias tahminini sıfırla
+ *   EVT n  : Olay tetikli motor davranışları (1=açık, 0=kapalı)
+ *   STATW i ms : i. istatistik penceresinin uzunluğu (ms)
+ *   FFTAX n    : Spektrum ekseni (0=X, 1=Y, 2=Z)
+ *   ACFG BEGIN | ACFG <hex> | ACFG END : Aktivite ağacı config blob'unu yükle
+ *   ACT        : Son aktivite özelliklerini yaz
+ *   PID n      : Kapalı çevrim kontrol (1=açık, 0=kapalı)
+ *   PIDG kp ki kd : PID kazançları
+ *   PIDSP x    : Setpoint
+ *   PIDFB s a  : Geri besleme (0=gyro hızı, 1=açı, 2=harici, 3=encoder rpm), eksen a
+ *   PIDDF hz   : Türev filtresi kesim frekansı
+ *   PIDEXT x   : Harici geri besleme değeri
+ *   PIDST      : PID durumu, tick süresi ve jitter
+ *   PIDSAVE    : Kazançları, türev filtresini ve kaynağı flash'a yaz (motoru süren kaynak yokken)
+ *   PIDLOAD    : Flash'taki kazançları geri yükle
+ *   TUNE d bias eps rule [s] : Röle ayarı ±d% (bias% etrafında), histerezis eps,
+ *                kural (0=ZN PID, 1=ZN PI, 2=Tyreus-Luyben, 3=az aşım, 4=aşımsız), zaman aşımı s
+ *   TUNESTOP   : Röle ayarını kes
+ *   TUNEST     : Röle ayarı durumu, Ku/Tu ve hesaplanan kazançlar
+ *   PFF g h [fc] : Gecikme telafisi - gyro hızı g·ẏ·(ölçülen gecikme + h ms) kadar ötelenir (g=0 kapalı)
+ *   LAT ms [a] : ms boyunca örnek -> PWM gecikmesi, telafili/telafisiz etkin gecikme (eksen a)
+ *   LATST      : Telafi ayarı ve son gecikme ölçümü
+ *   SYNC m [p] : Sensör okuma fazı (0=asenkron, 1=PWM iletim ortası, 2=periyodun p%'si)
+ *   SYNCST     : Senkron okuma kipi, bekleme süreleri, atlanan bekleme
+ *   NOISE ms   : Motor dönerken hareketsiz kartta senkron/asenkron RMS gürültü karşılaştırması
+ *   TXST       : UART gönderim tamponu doluluğu, tepe, atılan byte
+ *   RXST       : Komut alımı: işlenen/atılan satır, DMA olayı, en uzun işlenme gecikmesi
+ *   MSEL n     : Profil (PRAMP..PSTOP) ve MSET komutlarının motor kanalı (0..3, 0 = ana motor)
+ *   MSET d     : Seçili kanalda d% (d<0 geri yön)
+ *   MLIM n m i : Kanal n en fazla m%, i=1 yön ters
+ *   MCH        : Motor kanalları tablosu ve çıkışları
+ *   PRAMP d ms : Profil - mevcut çıkıştan d%'ye rampa (d<0 geri yön)
+ *   PHOLD d ms : Profil - d%'de tut (ms=0: durdurulana kadar)
+ *   PPULSE d on off n : Profil - darbe dizisi
+ *   PMOVE p c e a j : Profil - p%'ye hızlan (a %/s, jerk j %/s²), c ms seyret, e%'ye yavaşla
+ *   PBRAKE p ms : Profil - p% fren ms boyunca, sonra serbest
+ *   PSTOP      : Profili kes ve motoru durdur
+ *   PST        : Tüm kanalların profil durumu
+ *   MQ dt d r  : Zamanlı komut - son komuttan dt µs sonra d% duty, r yön (0=ileri, 1=geri)
+ *   MQFL       : Zamanlı kuyruğu boşalt
+ *   MQST       : Kuyruk derinliği, taşma ve gecikme
+ *   PWM hz [n] : PWM frekansı ve periyot başına adım (n yoksa en yüksek çözünürlük)
+ *   PWMST      : PWM frekansı, periyot ve çözünürlük
+ *   WGEN s a ms : DMA dalga formu yükle (0=sinüs ±a%, 1=kare, 2=üçgen), periyot ms
+ *   WPLAY n    : Yüklü dalgayı n kez çal (0=durdurulana kadar)
+ *   WQ d on off n : Dalga akışına segment ekle (d%, on/off ms, n darbe), akışı başlat
+ *   WSTOP      : Dalga çalmayı/akışı kes
+ *   WST        : Dalga durumu
+ *   MCURVE t min max k : Motor eğrisi (0=doğrusal, 1=üstel, 2=S), MCURVE DEF = derleme anı eğrisi
+ *   MCPT BEGIN | MCPT dps d | MCPT END : Özel eğri noktaları (d = %)
+ *   MCST       : Eğri tipi ve örnek noktalar
+ *   MOUT on off band slew : Çıkış koşullandırıcı (hassas duty birimi)
+ *   MOST       : Koşullandırıcı durumu ve bastırılan güncelleme sayaçları
+ *   ENC m cpr win stall : Hız geri beslemesi (0=quadrature, 1=tako), sayım/tur, pencere/takılma ms
+ *   ENCST      : Encoder sayımı, rpm ve takılma durumu
+ *   ILIM pk avg ms mv : Akım sınırları (mA), ortalama sınır süresi, sense kazancı (mV/A)
+ *   ICAL       : Motor dururken akım sıfır noktasını ölç
+ *   ICLR       : Aşırı akım hatasını temizle, PWM'i geri aç
+ *   IST        : Filtreli akım, sınırlar, hata ve kesme gecikmesi
+ *   BRK ms p   : p% fren ms boyunca, sonra serbest; durma süresi ölçülür
+ *   COAST      : Serbest durma, durma süresi ölçülür
+ *   STOPM m    : Varsayılan durma kipi (0=serbest, 1=fren)
+ *   STOPST     : Son durma süresi, kip başına ortalama/en iyi
+ *   ID s off amp pre ms [a b] : Sistem tanıma (0=basamak, 1=PRBS a=bit ms, 2=chirp a..b Hz), duty %
+ *   IDSRC s a dec : Kaydedilen yanıt (PIDFB numaraları), eksen, dec tick'te bir örnek
+ *   IDDUMP     : Kaydı ikili gönder ("SID1" başlık, örnekler, crc16)
+ *   IDSTOP     : Kaydı kes, motoru durdur
+ *   IDST       : Sistem tanıma durumu
+ */
+
+void Command_Init(void);
+void Command_Poll(void);
+void ProcessCommand(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __COMMAND_H__ */
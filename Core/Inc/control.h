@@ -0,0 +1,38 @@
+#ifndef __CONTROL_H__
+#define __CONTROL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Sabit hızlı kontrol tick'i - TIM6 update kesmesi (1 kHz)
+ * Kapalı çevrim kontrol bu kesmede koşar; ana döngüdeki UART/SPI gecikmeleri
+ * kontrol periyodunu etkilemez. Her tick'in çalışma süresi ve periyot sapması
+ * (jitter) DWT ile ölçülür. */
+
+#define CONTROL_TICK_HZ         1000
+#define CONTROL_DT_S            (1.0f / CONTROL_TICK_HZ)
+
+typedef struct {
+    uint32_t ticks;
+    uint32_t exec_cycles_max;
+    uint32_t exec_cycles_sum;
+    uint32_t exec_count;
+    int32_t jitter_min;             // Nominal periyottan sapma (cycle)
+    int32_t jitter_max;
+} Control_Stats_t;
+
+extern volatile Control_Stats_t control_stats;
+
+void Control_Init(void);
+void Control_Tick(void);
+void Control_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONTROL_H__ */
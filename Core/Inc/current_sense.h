@@ -0,0 +1,72 @@
+#ifndef __CURRENT_SENSE_H__
+#define __CURRENT_SENSE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Motor akımı - PA1 (ADC1_IN2), şönt/sürücü sense çıkışı
+ * ADC her PWM periyodunda TIM3_CC4 ile tetiklenir; CCR4 iletim süresinin
+ * ortasına kurulur (HW153_WritePulse), böylece şönt akımı dalgalanmanın
+ * ortalamasında örneklenir. Sonuçlar dairesel DMA ile tampona akar.
+ *  - Tepe: ADC analog watchdog'u eşiği aşan ilk dönüşümde kesme üretir,
+ *    ISR TIM3 CH1/CH2'yi "force inactive" yapar - CCR preload'unu beklemeden
+ *    çıkış us mertebesinde düşer. ADC1_2 tek preempt 0 kesmesidir (diğerleri
+ *    1), TIM3/TIM6/UART ISR'leri çalışırken de girer; gecikmeyi yalnız kısa
+ *    __disable_irq bölümleri (tampon/kuyruk güncellemeleri) uzatır.
+ *  - Ortalama: 1 kHz tick'te tampon ortalaması sw_trip_ms boyunca sınırı
+ *    aşarsa aynı kesme yolu çalışır.
+ * Hata kilitlenir; ICLR ile PWM kipi geri yüklenir. Dalga DMA'sı çalarken
+ * CCR4 güncellenmez, örnekleme son yazılan noktada kalır. */
+
+#define CURRENT_SENSE_SAMPLES   32      // DMA tamponu (20 kHz'de 1.6 ms)
+#define CURRENT_SENSE_FILTER_HZ 10.0f   // Telemetri alçak geçiren kesim frekansı
+#define CURRENT_SENSE_VREF_MV   3300.0f
+#define CURRENT_SENSE_FULL      4095
+
+typedef enum {
+    CURRENT_TRIP_NONE = 0,
+    CURRENT_TRIP_PEAK,          // Analog watchdog
+    CURRENT_TRIP_AVERAGE        // Yazılım ortalama sınırı
+} CurrentSense_Trip_t;
+
+typedef struct {
+    uint16_t peak_ma;           // Analog watchdog eşiği
+    uint16_t average_ma;        // Ortalama akım sınırı
+    uint16_t sw_trip_ms;        // Ortalama sınır üstünde kalma süresi
+    uint16_t mv_per_a;          // Sense kazancı (şönt x yükselteç)
+} CurrentSense_Config_t;
+
+typedef struct {
+    float filtered_ma;          // Alçak geçiren, telemetri
+    float average_ma;           // Son tick'in tampon ortalaması
+    float max_ma;               // Rapor aralığındaki en büyük tampon ortalaması
+    uint16_t offset;            // Sıfır akım ADC değeri
+    volatile CurrentSense_Trip_t fault;
+    uint32_t peak_trips;
+    uint32_t average_trips;
+    uint32_t trip_latency_cycles;   // Tetik (CC4) -> çıkış kesildi, timer saati
+} CurrentSense_Status_t;
+
+extern CurrentSense_Config_t current_sense_config;
+extern CurrentSense_Status_t current_sense_status;
+
+void CurrentSense_Init(void);
+HAL_StatusTypeDef CurrentSense_Calibrate(void);
+HAL_StatusTypeDef CurrentSense_Configure(uint16_t peak_ma, uint16_t average_ma,
+                                         uint16_t sw_trip_ms, uint16_t mv_per_a);
+void CurrentSense_Tick(void);
+void CurrentSense_WatchdogIRQ(void);
+void CurrentSense_Task(void);
+uint8_t CurrentSense_IsFaulted(void);
+void CurrentSense_ClearFault(void);
+void CurrentSense_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CURRENT_SENSE_H__ */
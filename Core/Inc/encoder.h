@@ -0,0 +1,60 @@
+#ifndef __ENCODER_H__
+#define __ENCODER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Motor hız geri beslemesi - TIM1, PA8 (CH1) / PA9 (CH2)
+ * QUADRATURE: encoder kipi, A/B kanallarının dört kenarı sayılır, yön donanımdan.
+ * TACH: tek hall/tako darbesi PA8'den harici saat olarak sayılır, yön motora
+ *       verilen komuttan alınır.
+ * 16 bit sayaç 1 kHz kontrol tick'inde işaretli farkla 32 bite genişletilir
+ * (tick başına 32767 sayımdan az olduğu sürece taşma kaçmaz). Hız:
+ *  - pencerede yeterli sayım varsa sayım / süre (pencere ortalaması),
+ *  - yavaşta son ENCODER_PERIOD_EDGES kenar aralığının ortalaması,
+ *  - stall_ms boyunca sayım yoksa 0; motor sürülüyorsa takılma sayılır. */
+
+#define ENCODER_HISTORY         64      // Hız penceresi üst sınırı (ms, tick başına bir örnek)
+#define ENCODER_PERIOD_EDGES    4       // Yavaşta ortalaması alınan kenar aralığı
+#define ENCODER_MIN_COUNTS      8       // Pencere yöntemi için gereken en az sayım
+
+typedef enum {
+    ENCODER_QUADRATURE = 0,
+    ENCODER_TACH,
+    ENCODER_MODE_COUNT
+} Encoder_Mode_t;
+
+typedef struct {
+    Encoder_Mode_t mode;
+    uint16_t counts_per_rev;    // Tur başına sayım (quadrature: 4 x PPR x dişli)
+    uint16_t window_ms;         // 1..ENCODER_HISTORY-1
+    uint16_t stall_ms;
+} Encoder_Config_t;
+
+typedef struct {
+    float rpm;                  // İşaretli, yön = motor yönü
+    uint8_t stalled;            // Sürülüyor ama sayım yok
+    uint32_t stalls;            // Takılma olayı sayısı
+    uint32_t period_estimates;  // Kenar aralığı yöntemiyle hesaplanan tick
+} Encoder_Status_t;
+
+extern Encoder_Config_t encoder_config;
+extern volatile Encoder_Status_t encoder_status;
+
+void Encoder_Init(void);
+HAL_StatusTypeDef Encoder_Configure(Encoder_Mode_t mode, uint16_t counts_per_rev,
+                                    uint16_t window_ms, uint16_t stall_ms);
+void Encoder_Tick(void);
+int32_t Encoder_GetCount(void);
+float Encoder_GetRpm(void);
+void Encoder_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ENCODER_H__ */
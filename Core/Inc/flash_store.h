@@ -0,0 +1,27 @@
+#ifndef __FLASH_STORE_H__
+#define __FLASH_STORE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Kalıcı ayar kaydı - flash'ın son sayfası (2 KB, linker script'te ayrıldı)
+ * Tek kayıt: magic | uzunluk | crc16 | veri. Yazma sayfayı siler; silme
+ * sırasında flash'tan kod okunamaz, kesmeler ~20-40 ms gecikir - sadece
+ * motor dururken çağrılmalı. Boş/bozuk/farklı uzunluktaki kayıt okunmaz. */
+
+#define FLASH_STORE_ADDR        0x0803F800U     // 256 KB flash'ın son sayfası
+#define FLASH_STORE_MAGIC       0x31464350U     // "PCF1"
+#define FLASH_STORE_MAX         (FLASH_PAGE_SIZE - 8)
+
+HAL_StatusTypeDef FlashStore_Load(void* data, uint16_t len);
+HAL_StatusTypeDef FlashStore_Save(const void* data, uint16_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLASH_STORE_H__ */
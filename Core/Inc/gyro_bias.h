@@ -0,0 +1,69 @@
+#ifndef __GYRO_BIAS_H__
+#define __GYRO_BIAS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Online gyro bias tahmini - eksen başına skaler Kalman filtresi
+ * Durum: bias (dps), model: random walk. Ölçüm: kart hareketsizken ham hız.
+ * Üç eksen aynı Q/R ve aynı güncelleme anlarını paylaştığı için varyans (P)
+ * ve kazanç (K) ortaktır: örnek başına tek bölme + 3 çarp-topla.
+ * Hareketsizlik ivme ve ham hızın örnekler arası değişimiyle belirlenir.
+ * Ek olarak düzeltilmiş hız baştan itibaren kapıdan geçmeli: sınır
+ *   |ω - bias|² < GATE² + SIGMA² · P
+ * P0 sıfır hız ofsetini (L3GD20: eksen başına ±10 dps'e kadar) kapsar, P
+ * küçüldükçe sınır GATE'e daralır - yerçekimi ekseni etrafında sabit hızlı
+ * dönüş (ivme değişmez) baştan reddedilir, bias ona yakınsamaz. Diğer
+ * koşullar sağlanıp yalnız kapı REOPEN_COUNT örnek üst üste reddederse
+ * bias kaymış sayılır, P = P0 ile kapı yeniden açılır. */
+
+// Tuning (örnek başına)
+#define GYRO_BIAS_Q             1.0e-7f  // Bias random walk varyansı (dps²/örnek)
+#define GYRO_BIAS_R             0.09f    // Ölçüm gürültüsü varyansı (~0.3 dps RMS)
+#define GYRO_BIAS_P0            50.0f    // Başlangıç belirsizliği - ~7 dps σ, sıfır hız ofsetini kapsar
+
+// Hareketsizlik (still) tespiti
+// 100 Hz örneklemeye göre: tek örnek ivme gürültüsü ve kalibrasyonsuz LSM303
+// ölçek hatası (~%1-2) ±0.005g'yi aşar, still sayacı 200 ms hareketsizlik ister
+#define GYRO_BIAS_ACC_TOL_G2    0.04f    // | |a|² - 1g² | sınırı (~±0.02g)
+#define GYRO_BIAS_ACC_DELTA_G   0.02f    // Ardışık örnekler arası ivme değişimi sınırı (g)
+#define GYRO_BIAS_GYRO_DELTA_DPS 1.5f    // Ardışık ham hız örnekleri arası değişim sınırı (~3.5σ gürültü)
+#define GYRO_BIAS_GYRO_GATE_DPS 3.0f     // Oturmuş bias'ta düzeltilmiş hız sınırı
+#define GYRO_BIAS_GATE_SIGMA    3.0f     // Kapı genişliği: bias belirsizliğinin kaç σ'sı eklenir
+#define GYRO_BIAS_REOPEN_COUNT  500      // Sadece kapı reddi bu kadar sürerse P sıfırlanır (10 ms'de 5 s)
+#define GYRO_BIAS_STILL_COUNT   20       // Güncellemeye başlamadan önce ardışık still örnek (10 ms'de 200 ms)
+
+typedef struct {
+    float bias[3];          // Tahmini bias (dps) - X, Y, Z
+    float P;                // Tahmin varyansı (dps²)
+    float last_acc[3];      // Önceki ivme örneği (g)
+    float last_raw[3];      // Önceki ham hız örneği (dps)
+    uint32_t still_count;   // Ardışık still örnek sayısı
+    uint32_t gate_rejects;  // Ardışık, yalnız düzeltilmiş hız kapısının reddettiği örnek
+    uint32_t reopens;       // Bias kayması nedeniyle P sıfırlama
+    uint32_t updates;       // Toplam Kalman güncellemesi
+    uint32_t samples;       // Toplam işlenen örnek
+    uint8_t accel_ok;       // İvmeölçer yoksa sadece predict çalışır
+} GyroBias_t;
+
+extern GyroBias_t gyro_bias;
+
+void GyroBias_Init(uint8_t accel_ok);
+void GyroBias_Process(L3GD20_Data_t* data, const float acc[3]);
+void GyroBias_Report(void);
+
+static inline uint8_t GyroBias_IsStill(void)
+{
+    return gyro_bias.still_count >= GYRO_BIAS_STILL_COUNT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GYRO_BIAS_H__ */
@@ -53,7 +53,7 @@ extern "C" {
 /* Exported types ------------------------------------------------------------*/
 /* USER CODE BEGIN ET */
 #define UART_BUFFER_SIZE 256
-#define RX_BUFFER_SIZE   32
+#define RX_BUFFER_SIZE   64      // USART2 RX dairesel DMA halkası
 /* USER CODE END ET */
 
 /* Exported constants --------------------------------------------------------*/
@@ -64,8 +64,8 @@ extern char debugMsg[UART_BUFFER_SIZE];
 extern uint8_t rxBuffer[RX_BUFFER_SIZE];
 
 // Timer tanımlamaları
-#define TIM3_PRESCALER  71
-#define TIM3_PERIOD     999
+#define TIM3_PRESCALER  0       // 72MHz timer clock
+#define TIM3_PERIOD     3599    // 20kHz PWM, 3600 adım (Motor_ConfigurePwm ile değişir)
 
 // LED Pin Tanımlamaları
 #define LD3_Pin                 GPIO_PIN_9
@@ -86,12 +86,39 @@ extern uint8_t rxBuffer[RX_BUFFER_SIZE];
 #define LD10_GPIO_Port         GPIOE
 
 // HW-153 V1 Motor Driver Pin Tanımlamaları
-#define MOTOR_PWM_PIN          GPIO_PIN_6   // PA6 - TIM3_CH1 (INA pin)
-#define MOTOR_PWM_GPIO_Port    GPIOA
-#define MOTOR_PWM_CHANNEL      TIM_CHANNEL_1
-
-#define MOTOR_DIR_PIN          GPIO_PIN_7   // PA7 - Direction pin (INB pin)  
-#define MOTOR_DIR_GPIO_Port    GPIOA
+// PA6/PA7 SPI1 MISO/MOSI'ye ait - motor TIM3 CH1/CH2 üzerinden PC6/PC7'de
+#define MOTOR_INA_PIN          GPIO_PIN_6   // PC6 - TIM3_CH1 (INA, ileri PWM)
+#define MOTOR_INA_GPIO_Port    GPIOC
+#define MOTOR_INA_CHANNEL      TIM_CHANNEL_1
+
+#define MOTOR_INB_PIN          GPIO_PIN_7   // PC7 - TIM3_CH2 (INB, geri PWM)
+#define MOTOR_INB_GPIO_Port    GPIOC
+#define MOTOR_INB_CHANNEL      TIM_CHANNEL_2
+
+// Ek motor kanalları - TIM4 (AF2), motor_channels[] tablosu
+#define MOTOR1_INA_PIN         GPIO_PIN_12  // PD12 - TIM4_CH1 (M1 INA)
+#define MOTOR1_INB_PIN         GPIO_PIN_13  // PD13 - TIM4_CH2 (M1 INB)
+#define MOTOR1_INA_CHANNEL     TIM_CHANNEL_1
+#define MOTOR1_INB_CHANNEL     TIM_CHANNEL_2
+#define MOTOR2_PWM_PIN         GPIO_PIN_14  // PD14 - TIM4_CH3 (M2 PWM)
+#define MOTOR2_PWM_CHANNEL     TIM_CHANNEL_3
+#define MOTOR2_DIR_PIN         GPIO_PIN_10  // PD10 - M2 yön
+#define MOTOR2_DIR_GPIO_Port   GPIOD
+#define MOTOR3_PWM_PIN         GPIO_PIN_15  // PD15 - TIM4_CH4 (M3 PWM)
+#define MOTOR3_PWM_CHANNEL     TIM_CHANNEL_4
+#define MOTOR3_DIR_PIN         GPIO_PIN_11  // PD11 - M3 yön
+#define MOTOR3_DIR_GPIO_Port   GPIOD
+#define MOTOR_TIM4_GPIO_Port   GPIOD
+
+// Akım algılama - ADC1 TIM3 CH4 compare olayıyla tetiklenir (CH4 pine çıkmaz)
+#define MOTOR_SENSE_CHANNEL    TIM_CHANNEL_4
+#define CURRENT_SENSE_PIN      GPIO_PIN_1   // PA1 - ADC1_IN2 (şönt/sense)
+#define CURRENT_SENSE_GPIO_Port GPIOA
+
+// Motor encoder/tako girişi - TIM1 CH1/CH2 (AF6)
+#define ENCODER_A_PIN          GPIO_PIN_8   // PA8 - TIM1_CH1 (encoder A veya tek tako)
+#define ENCODER_B_PIN          GPIO_PIN_9   // PA9 - TIM1_CH2 (encoder B)
+#define ENCODER_GPIO_Port      GPIOA
 
 // Motor yön tanımlamaları
 #define MOTOR_DIRECTION_FORWARD   0
@@ -108,7 +135,10 @@ extern uint8_t rxBuffer[RX_BUFFER_SIZE];
 // Peripheral handles
 extern I2C_HandleTypeDef hi2c1;
 extern SPI_HandleTypeDef hspi1;
+extern TIM_HandleTypeDef htim2;
 extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim6;
+extern DMA_HandleTypeDef hdma_tim3_up;
 extern UART_HandleTypeDef huart2;
 
 /* Exported macro ------------------------------------------------------------*/
@@ -122,7 +152,10 @@ void SystemClock_Config(void);
 void MX_GPIO_Init(void);
 void MX_I2C1_Init(void);
 void MX_SPI1_Init(void);
+void MX_TIM2_Init(void);
 void MX_TIM3_Init(void);
+void MX_TIM6_Init(void);
+void MX_DMA_Init(void);
 void MX_USART2_UART_Init(void);
 void MX_USB_PCD_Init(void);
 
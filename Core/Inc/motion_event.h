@@ -0,0 +1,71 @@
+#ifndef __MOTION_EVENT_H__
+#define __MOTION_EVENT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Hareket olayı algılayıcı - örnek akışı üzerinde durum makineleri
+ *   SHAKE    : Pencere içinde N adet eşik-üstü yön değişimi (herhangi bir eksen)
+ *   TAP      : Kısa ivme sıçraması (jerk), ardından sakinleşme
+ *   ROTATION : Sürekli dönüş (magnitude eşik üstünde belirli süre)
+ *   REST     : Hareketten sonra hareketsizliğe dönüş
+ * Her olay tek satırlık telemetri olarak raporlanır ve (etkinse) motor davranışını tetikler. */
+
+// SHAKE
+#define EVT_SHAKE_THRESH_DPS     60.0f   // Yön değişimi sayılması için gereken hız
+#define EVT_SHAKE_CROSSINGS      4       // Pencere içindeki yön değişimi sayısı
+#define EVT_SHAKE_WINDOW_MS      1000
+// TAP
+#define EVT_TAP_JERK_G           0.5f    // Ardışık ivme örnekleri arası fark
+#define EVT_TAP_MAX_MS           60      // Sıçrama bu süreden uzunsa tap değil
+#define EVT_TAP_QUIET_G          0.1f    // Sıçrama sonrası sakin sayılma sınırı
+// ROTATION / REST
+#define EVT_ROT_THRESH_DPS       20.0f
+#define EVT_ROT_MIN_MS           300
+#define EVT_REST_THRESH_DPS      3.0f
+#define EVT_REST_MIN_MS          500
+// Olay sonrası aynı olayın tekrar üretilmediği süre
+#define EVT_REFRACTORY_MS        500
+
+typedef enum {
+    MOTION_EVENT_NONE = 0,
+    MOTION_EVENT_SHAKE,
+    MOTION_EVENT_TAP,
+    MOTION_EVENT_ROTATION,
+    MOTION_EVENT_REST,
+    MOTION_EVENT_COUNT
+} MotionEvent_Type_t;
+
+typedef enum {
+    MOTOR_ACTION_NONE = 0,
+    MOTOR_ACTION_PULSE,     // speed'de on_ms açık / off_ms kapalı, count kez
+    MOTOR_ACTION_RAMP,      // on_ms içinde speed'e rampa, sonra tut
+    MOTOR_ACTION_STOP
+} MotorAction_Type_t;
+
+typedef struct {
+    MotorAction_Type_t type;
+    uint8_t speed;          // %
+    uint16_t on_ms;
+    uint16_t off_ms;
+    uint8_t count;
+} MotorAction_t;
+
+extern uint32_t motion_event_counts[MOTION_EVENT_COUNT];
+
+void MotionEvent_Init(void);
+void MotionEvent_Process(const L3GD20_Data_t* gyro, const float acc[3], uint32_t now_ms);
+void MotionEvent_SetMotorEnabled(uint8_t enabled);
+uint8_t MotionEvent_MotorActive(void);
+const char* MotionEvent_Name(MotionEvent_Type_t type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTION_EVENT_H__ */
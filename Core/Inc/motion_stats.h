@@ -0,0 +1,59 @@
+#ifndef __MOTION_STATS_H__
+#define __MOTION_STATS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Pencereli hareket istatistikleri - cihaz üzerinde, örnek başına O(1)
+ * Her pencere kendi uzunluğunda (ör. 100ms / 1s / 10s) toplanır: eksen başına
+ * Welford ortalama/varyans, min/max, RMS ve magnitude tepe değeri. Pencere
+ * kapanınca sonuç anlık görüntüye (snapshot) alınır ve düşük hızda raporlanır. */
+
+#define MOTION_STATS_WINDOWS        3
+#define MOTION_STATS_REPORT_MS      1000    // Rapor periyodu
+
+typedef struct {
+    uint32_t n;
+    float mean[3];
+    float m2[3];            // Welford: ortalamadan sapma karelerinin toplamı
+    float min[3];
+    float max[3];
+    float sum_sq[3];        // RMS için
+    float peak_mag;
+} MotionStats_Acc_t;
+
+typedef struct {
+    uint32_t n;
+    float mean[3];
+    float std[3];
+    float min[3];
+    float max[3];
+    float rms[3];
+    float peak_mag;
+    uint32_t seq;           // Kapanan pencere sayısı (0 = henüz sonuç yok)
+} MotionStats_Result_t;
+
+typedef struct {
+    uint32_t length_ms;     // Pencere uzunluğu
+    uint32_t start_ms;
+    MotionStats_Acc_t acc;
+    MotionStats_Result_t last;
+} MotionStats_Window_t;
+
+extern MotionStats_Window_t motion_stats[MOTION_STATS_WINDOWS];
+
+void MotionStats_Init(void);
+void MotionStats_SetWindow(uint8_t index, uint32_t length_ms);
+void MotionStats_Update(const L3GD20_Data_t* data, uint32_t now_ms);
+void MotionStats_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTION_STATS_H__ */
@@ -6,12 +6,12 @@ extern "C" {
 #endif
 
 #include "main.h"
+#include "motor_channel.h"
 #include <stdint.h>
 
 /* Function Prototypes */
 void SetPWMDuty(uint8_t duty);
 void SetMotorSpeed(uint8_t speed);
-void ProcessCommand(void);
 extern void SendDebugMessage(const char* msg);
 
 /* Motor Döndürme Fonksiyonları */
@@ -20,8 +20,25 @@ void Motor_Test(void);
 void Motor_SimpleTest(void);
 void Motor_PinTest(void);
 
-/* HW-153 V1 Motor Driver Fonksiyonları */
+/* Hassas duty ölçeği: MOTOR_DUTY_FULL = %100 (0.01% adım) */
+#define MOTOR_DUTY_FULL         10000
+#define MOTOR_PWM_MIN_STEPS     100     // Periyot başına en az compare adımı
+#define MOTOR_PWM_MAX_STEPS     65535   // ARR <= 65534: tam fren CCR = ARR+1 16 bite sığar
+
+/* HW-153 V1 Motor Driver Fonksiyonları - ana motor kanalı (MOTOR_MAIN) */
 void HW153_SetMotor(uint8_t speed, uint8_t direction);
+void HW153_WriteDuty(uint8_t speed, uint8_t direction);
+void HW153_WriteDutyFine(int32_t duty);
+void HW153_WritePulse(int32_t pulse);
+int32_t HW153_GetPulse(void);
+void HW153_WriteBrake(int32_t pulse);
+uint8_t HW153_IsBraking(void);
+void HW153_Stop(Motor_StopMode_t mode);
+void Motor_SetStopMode(Motor_StopMode_t mode);
+Motor_StopMode_t Motor_GetStopMode(void);
+uint32_t Motor_PwmFrequency(void);
+HAL_StatusTypeDef Motor_ConfigurePwm(uint32_t freq_hz, uint32_t steps);
+void Motor_PwmReport(void);
 void HW153_MotorTest(void);
 void Motor_RotateClockwise(uint8_t speed, uint32_t duration_ms);
 void Motor_RotateCounterClockwise(uint8_t speed, uint32_t duration_ms);
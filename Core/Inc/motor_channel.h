@@ -0,0 +1,75 @@
+#ifndef __MOTOR_CHANNEL_H__
+#define __MOTOR_CHANNEL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Motor kanalı - timer, compare kanalları, yön pini, polarite ve sınır
+ * Kanallar motor_channels[] tablosunda tanımlıdır; tüm sürüş fonksiyonları
+ * kanal tutamacı (MotorChannel_t*) alır. Sürüş tipleri:
+ *  DUAL_PWM: HW-153 gibi iki girişli köprü - ileri A'da, geri B'de PWM, fren ikisi
+ *  PWM_DIR : tek PWM + yön pini; fren desteklenmez (serbest durur)
+ * Tüm kanallar aynı PWM frekansındadır (Motor_ConfigurePwm TIM3 ve TIM4'ü birlikte ayarlar).
+ * Yazma yolu ISR'den çağrılır ve bölme içermez: compare sınırı ve hassas duty
+ * ölçeği ARR/sınır değişince MotorChannel_UpdateScale ile önceden hesaplanır.
+ * Ana motor (MOTOR_MAIN) akım algılama, encoder, PID ve dalga DMA'sını taşır. */
+
+#define MOTOR_CHANNEL_COUNT     4
+#define MOTOR_CHANNEL_NONE      0xFFFFFFFFU
+
+/* Durma kipi: COAST = INA=INB=LOW (serbest), BRAKE = INA=INB=HIGH (sargı kısa devre) */
+typedef enum {
+    MOTOR_STOP_COAST = 0,
+    MOTOR_STOP_BRAKE
+} Motor_StopMode_t;
+
+typedef enum {
+    MOTOR_DRIVE_DUAL_PWM = 0,
+    MOTOR_DRIVE_PWM_DIR
+} MotorChannel_Drive_t;
+
+typedef struct {
+    const char* name;
+    TIM_HandleTypeDef* htim;
+    MotorChannel_Drive_t drive;
+    uint32_t channel_a;         // DUAL_PWM: INA (ileri), PWM_DIR: PWM
+    uint32_t channel_b;         // DUAL_PWM: INB (geri)
+    uint32_t sense_channel;     // ADC tetik compare'ı, MOTOR_CHANNEL_NONE = yok
+    GPIO_TypeDef* dir_port;     // PWM_DIR: yön pini
+    uint16_t dir_pin;
+    uint8_t invert;             // Bağlantı ters - yön çevrilir
+    uint16_t max_duty;          // Hassas duty sınırı (MOTOR_DUTY_FULL = %100)
+    int32_t limit;              // max_duty'nin compare karşılığı (ARR'den)
+    uint32_t duty_scale;        // Hassas duty -> compare, Q16: ARR · 65536 / MOTOR_DUTY_FULL
+
+    volatile int32_t pulse;     // Son yazılan compare, işaret = komut yönü
+    volatile uint8_t braking;
+} MotorChannel_t;
+
+extern MotorChannel_t motor_channels[MOTOR_CHANNEL_COUNT];
+
+#define MOTOR_MAIN              (&motor_channels[0])
+
+MotorChannel_t* MotorChannel_Get(uint8_t index);
+uint8_t MotorChannel_Index(const MotorChannel_t* ch);
+void MotorChannel_UpdateScale(MotorChannel_t* ch);
+void MotorChannel_WritePulse(MotorChannel_t* ch, int32_t pulse);
+void MotorChannel_WriteDutyFine(MotorChannel_t* ch, int32_t duty);
+int32_t MotorChannel_DutyToCompare(const MotorChannel_t* ch, int32_t duty, uint16_t pair[2]);
+void MotorChannel_WriteBrake(MotorChannel_t* ch, int32_t pulse);
+void MotorChannel_Stop(MotorChannel_t* ch, Motor_StopMode_t mode);
+int32_t MotorChannel_GetPulse(const MotorChannel_t* ch);
+uint8_t MotorChannel_GetPercent(const MotorChannel_t* ch);
+int32_t MotorChannel_Period(const MotorChannel_t* ch);
+HAL_StatusTypeDef MotorChannel_SetLimits(MotorChannel_t* ch, uint16_t max_duty, uint8_t invert);
+void MotorChannel_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_CHANNEL_H__ */
@@ -0,0 +1,59 @@
+#ifndef __MOTOR_CURVE_H__
+#define __MOTOR_CURVE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Gyro büyüklüğü -> motor duty transfer eğrisi (ön hesaplanmış tablo)
+ * Tablo büyüklüğün karesiyle (ham LSB², karekök yok) indekslenir: hücre =
+ * mag2 >> motor_curve_shift, değer = hassas duty (0..MOTOR_DUTY_FULL). Eşleme
+ * bir kaydırma ve bir okumadır. Kaydırma eğri kurulurken max_dps'i tabloya
+ * sığdıran en küçük değer seçilir (en az MOTOR_CURVE_SHIFT, ~12.7 dps);
+ * büyük max_dps'te alt uç çözünürlüğü buna göre kabalaşır. Varsayılan eğri derleme anında üretilmiş sabit
+ * tablodur (gen_motor_curve.py -> motor_curve_table.c); doğrusal, üstel,
+ * S-eğrisi veya UART'tan yüklenen noktalar RAM tablosuna hesaplanır. */
+
+#define MOTOR_CURVE_SIZE        1024
+#define MOTOR_CURVE_SHIFT       11          // Hücre başına 2048 LSB² (~0.4 dps ilk hücre), varsayılan tablo
+#define MOTOR_CURVE_SHIFT_MAX   22          // 1024 << 22 = 2³² LSB² (~573 dps, uint32 mag2 sınırı)
+#define MOTOR_CURVE_MAX_POINTS  16          // Özel eğri nokta sayısı
+
+typedef enum {
+    MOTOR_CURVE_LINEAR = 0,
+    MOTOR_CURVE_EXPO,           // (e^(k·t) - 1) / (e^k - 1)
+    MOTOR_CURVE_SCURVE,         // Logistic, k = diklik
+    MOTOR_CURVE_CUSTOM,         // Noktalar arası doğrusal
+    MOTOR_CURVE_DEFAULT,        // Derleme anı tablosu
+    MOTOR_CURVE_TYPE_COUNT
+} MotorCurve_Type_t;
+
+typedef struct {
+    float dps;
+    uint16_t duty;              // 0..MOTOR_DUTY_FULL
+} MotorCurve_Point_t;
+
+extern const uint16_t motor_curve_default[MOTOR_CURVE_SIZE];
+extern const uint16_t* volatile motor_curve;
+extern volatile uint8_t motor_curve_shift;
+
+void MotorCurve_Init(void);
+HAL_StatusTypeDef MotorCurve_Build(MotorCurve_Type_t type, float min_dps, float max_dps, float k);
+HAL_StatusTypeDef MotorCurve_BuildCustom(const MotorCurve_Point_t* points, uint8_t count);
+void MotorCurve_Report(void);
+
+/* Sıcak yol: karesi alınmış büyüklük (ham LSB²) -> hassas duty */
+static inline uint16_t MotorCurve_Lookup(uint32_t mag2)
+{
+    uint32_t index = mag2 >> motor_curve_shift;
+    return motor_curve[(index < MOTOR_CURVE_SIZE) ? index : (MOTOR_CURVE_SIZE - 1)];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_CURVE_H__ */
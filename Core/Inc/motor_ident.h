@@ -0,0 +1,73 @@
+#ifndef __MOTOR_IDENT_H__
+#define __MOTOR_IDENT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "pid.h"
+#include <stdint.h>
+
+/* Sistem tanıma - ana motora uyarım uygular, yanıtı RAM'e kaydeder
+ * Kontrol tick'inde (1 kHz) koşar. Önce pre_ms boyunca offset duty'de
+ * beklenir (basamağın tabanı / çalışma noktası), sonra duration_ms boyunca:
+ *  - STEP:  offset + amplitude
+ *  - PRBS:  offset ± amplitude, 9 bit LFSR (x^9 + x^5 + 1, 511 bit), bit_ms'de bir bit
+ *  - CHIRP: offset + amplitude·sin, f0'dan f1'e doğrusal frekans taraması
+ * Her decim tick'te bir (duty, yanıt) çifti kaydedilir. Yanıt, duty
+ * yazılmadan önce okunur: y[k] önceki tick'lerin girişinin sonucudur.
+ * Yanıt kaynağı PID ile aynıdır; gyro/açı örnekleme döngüsünde (100 Hz)
+ * güncellenir ve tick'te son değer okunur (ZOH), rpm her tick hesaplanır.
+ * Başka kaynak (PID/profil/dalga/kuyruk) motoru alırsa veya aşırı akım
+ * hatası olursa kayıt kesilir. Biten kayıt MotorIdent_Dump ile ikili gönderilir. */
+
+#define MOTOR_IDENT_MAX_SAMPLES 2048    // int16 duty + float yanıt = 12 KB
+#define MOTOR_IDENT_MAGIC       "SID1"
+#define MOTOR_IDENT_HEADER      28      // Dump başlığı (byte)
+
+typedef enum {
+    MOTOR_IDENT_STEP = 0,
+    MOTOR_IDENT_PRBS,
+    MOTOR_IDENT_CHIRP,
+    MOTOR_IDENT_SIGNAL_COUNT
+} MotorIdent_Signal_t;
+
+typedef enum {
+    MOTOR_IDENT_IDLE = 0,       // Kayıt yok
+    MOTOR_IDENT_RUNNING,
+    MOTOR_IDENT_DONE,
+    MOTOR_IDENT_ABORTED         // Kesildi - o ana kadarki örnekler geçerli
+} MotorIdent_State_t;
+
+typedef struct {
+    MotorIdent_Signal_t signal;
+    int16_t offset;             // Hassas duty, işaret = yön
+    int16_t amplitude;          // Hassas duty
+    uint16_t pre_ms;            // Uyarım öncesi offset'te bekleme
+    uint16_t duration_ms;       // Uyarım süresi
+    float param_a;              // PRBS: bit süresi (ms), CHIRP: başlangıç frekansı (Hz)
+    float param_b;              // CHIRP: bitiş frekansı (Hz)
+    Pid_Feedback_t source;      // Kaydedilen yanıt
+    uint8_t axis;
+    uint16_t decim;             // Kayıt aralığı (tick)
+} MotorIdent_Config_t;
+
+extern MotorIdent_Config_t motor_ident_config;
+
+void MotorIdent_Init(void);
+HAL_StatusTypeDef MotorIdent_SetSource(Pid_Feedback_t source, uint8_t axis, uint16_t decim);
+HAL_StatusTypeDef MotorIdent_Start(MotorIdent_Signal_t signal, int16_t offset, int16_t amplitude,
+                                   uint16_t pre_ms, uint16_t duration_ms, float param_a, float param_b);
+void MotorIdent_Stop(void);
+uint8_t MotorIdent_IsRunning(void);
+void MotorIdent_Tick(void);
+void MotorIdent_Task(void);
+HAL_StatusTypeDef MotorIdent_Dump(void);
+void MotorIdent_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_IDENT_H__ */
@@ -0,0 +1,49 @@
+#ifndef __MOTOR_OUTPUT_H__
+#define __MOTOR_OUTPUT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Motor çıkış koşullandırıcı - büyüklük haritası ile PWM register'ı arasında
+ * Örnekleme hızında çağrılır (Sample_Process, 100 Hz). Sırasıyla:
+ *  1. Ölü bölge histerezisi: duran motor |hedef| >= on eşiğinde kalkar,
+ *     dönen motor |hedef| < off eşiğinde durur - eşik civarında açıp kapamaz
+ *  2. Histerezis bandı: çıkıştan band kadar farklı olmayan hedef yok sayılır
+ *  3. Eğim sınırı: tick başına en fazla slew kadar değişim
+ *  4. Register sadece değer değişince yazılır
+ * Değerler hassas duty ölçeğindedir (MOTOR_DUTY_FULL = %100). */
+
+typedef struct {
+    uint16_t deadband_on;       // Kalkış eşiği
+    uint16_t deadband_off;      // Durma eşiği (<= deadband_on)
+    uint16_t hysteresis;        // Yok sayılan küçük değişim
+    uint16_t slew_per_tick;     // Tick başına en fazla değişim, 0 = sınırsız
+} MotorOutput_Config_t;
+
+typedef struct {
+    uint32_t updates;           // Update çağrısı
+    uint32_t writes;            // Register yazımı
+    uint32_t unchanged;         // Değişmediği için yazılmayan
+    uint32_t deadband;          // Ölü bölgede sıfırlanan hedef
+    uint32_t hysteresis;        // Histerezis bandında yok sayılan
+    uint32_t slew_limited;      // Eğim sınırına takılan
+} MotorOutput_Stats_t;
+
+extern MotorOutput_Config_t motor_output_config;
+extern MotorOutput_Stats_t motor_output_stats;
+
+void MotorOutput_Init(void);
+void MotorOutput_Update(int32_t target);
+void MotorOutput_Release(void);
+int32_t MotorOutput_Get(void);
+void MotorOutput_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_OUTPUT_H__ */
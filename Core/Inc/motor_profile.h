@@ -0,0 +1,62 @@
+#ifndef __MOTOR_PROFILE_H__
+#define __MOTOR_PROFILE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "speed_profile.h"
+#include "motor_channel.h"
+#include <stdint.h>
+
+/* Bloklamayan motor profil motoru - TIM3 (PWM) update kesmesinde koşar
+ * Her motor kanalının bağımsız profili vardır; hepsi aynı kesmede ilerler.
+ * Profil rampa, darbe dizisi ve tutma segmentlerinden oluşur. Süreler ve rampa
+ * adımları başlatırken PWM periyodu cinsine çevrilir; ISR'da bölme yoktur ve
+ * her PWM periyodunda bir adım atılır. Yeni profil çalışan profili kesintisiz
+ * (mevcut çıkıştan devam ederek) değiştirir. MOVE segmenti jerk sınırlı
+ * hızlan-seyret-yavaşla profilidir (speed_profile). */
+
+#define MOTOR_PROFILE_MAX_SEGMENTS  8
+#define MOTOR_PROFILE_MAX_MOVES     2       // Profil başına MOVE segmenti
+#define MOTOR_PROFILE_OPEN_ENDED    0xFFFFFFFFUL
+
+typedef enum {
+    MOTOR_SEG_HOLD = 0,     // duty'de time_ms tut (0 = iptal edilene kadar)
+    MOTOR_SEG_RAMP,         // Mevcut çıkıştan duty'ye time_ms içinde doğrusal
+    MOTOR_SEG_PULSE,        // duty'de time_ms açık / off_ms kapalı, count kez; 0'da biter
+    MOTOR_SEG_MOVE,         // Mevcut çıkıştan duty'ye hızlan, time_ms seyret, end_duty'ye yavaşla
+    MOTOR_SEG_BRAKE         // |duty| oranında time_ms fren, sonra serbest (çıkış 0)
+} MotorSegment_Type_t;
+
+typedef struct {
+    MotorSegment_Type_t type;
+    int8_t duty;            // -100..100 (%), işaret = yön
+    uint16_t time_ms;
+    uint16_t off_ms;
+    uint8_t count;
+    int8_t end_duty;        // MOVE: bitiş duty'si
+    uint16_t accel;         // MOVE: %/s
+    uint16_t jerk;          // MOVE: %/s², 0 = trapez
+} MotorSegment_t;
+
+typedef struct {
+    uint32_t started;
+    uint32_t completed;
+    uint32_t replaced;      // Çalışırken yenisiyle değiştirilen
+    uint32_t cancelled;
+} MotorProfile_Stats_t;
+
+HAL_StatusTypeDef MotorProfile_Start(MotorChannel_t* ch, const MotorSegment_t* segments, uint8_t count);
+void MotorProfile_Cancel(MotorChannel_t* ch);
+uint8_t MotorProfile_IsActive(const MotorChannel_t* ch);
+void MotorProfile_Tick(void);
+uint32_t MotorProfile_ExpectedMs(const MotorChannel_t* ch);
+void MotorProfile_Report(const MotorChannel_t* ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_PROFILE_H__ */
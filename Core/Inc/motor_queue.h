@@ -0,0 +1,55 @@
+#ifndef __MOTOR_QUEUE_H__
+#define __MOTOR_QUEUE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Zaman damgalı motor komut kuyruğu - tek üretici / tek tüketici, kilitsiz
+ * Üretici ana döngü, tüketici TIM2 compare kesmesidir. TIM2 1 MHz'de serbest
+ * sayan 32 bit sayaçtır; baştaki komutun zamanı CCR1'e yazılır ve eşleşmede
+ * komut uygulanır (µs hassasiyet). Üretici ekledikten sonra CC1 olayını
+ * yazılımla tetikler, kesme sayacı yeniden kurar - timer'a tek yazan ISR'dır.
+ * Ana motorun sahibi son başlayan komut kaynağıdır: Push profili ve dalgayı
+ * durdurur, profil veya dalga başlarsa kuyruk boşaltılır. Olay davranışları
+ * kuyruk ya da dalga aktifken hiç başlamaz - otomatik yol komutları kesmez. */
+
+#define MOTOR_QUEUE_SIZE        32      // 2'nin kuvveti olmalı
+
+typedef struct {
+    uint32_t time_us;       // TIM2 zaman damgası
+    uint8_t duty;           // %
+    uint8_t direction;
+} MotorCommand_t;
+
+typedef struct {
+    uint32_t pushed;
+    uint32_t applied;
+    uint32_t overruns;      // Kuyruk doluyken reddedilen
+    uint32_t high_water;
+    uint32_t late_max_us;   // Planlanan zamandan sonra uygulama gecikmesi
+    uint32_t late_sum_us;
+} MotorQueue_Stats_t;
+
+extern volatile MotorQueue_Stats_t motor_queue_stats;
+
+void MotorQueue_Init(void);
+HAL_StatusTypeDef MotorQueue_Push(uint32_t time_us, uint8_t duty, uint8_t direction);
+uint32_t MotorQueue_Depth(void);
+uint32_t MotorQueue_LastTime(void);
+void MotorQueue_Flush(void);
+void MotorQueue_Report(void);
+
+static inline uint32_t MotorQueue_Now(void)
+{
+    return TIM2->CNT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_QUEUE_H__ */
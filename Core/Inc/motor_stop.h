@@ -0,0 +1,54 @@
+#ifndef __MOTOR_STOP_H__
+#define __MOTOR_STOP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "motor.h"
+#include <stdint.h>
+
+/* Durma süresi ölçümü - fren/serbest durma profil motoruyla uygulanır,
+ * hız eşiğin altına inip settle_ms boyunca kaldığı ana kadar geçen süre ölçülür.
+ * Kaynak başlangıçta seçilir: encoder dönüyorsa rpm (1 kHz), değilse gyro
+ * büyüklüğü (örnekleme hızı, 10 ms çözünürlük). Ölçüm sürerken hız haritası
+ * motoru sürmez. Kip başına sayı/ortalama/en iyi süre tutulur. */
+
+typedef enum {
+    MOTOR_STOP_SRC_NONE = 0,    // Zaten duruyordu - ölçüm yok
+    MOTOR_STOP_SRC_RPM,
+    MOTOR_STOP_SRC_GYRO
+} MotorStop_Source_t;
+
+typedef struct {
+    float stop_rpm;             // |rpm| bu değerin altında = durdu
+    float stop_dps;             // Gyro büyüklüğü eşiği
+    uint16_t settle_ms;         // Eşik altında kalma süresi
+    uint16_t timeout_ms;
+} MotorStop_Config_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t last_ms;
+    uint32_t sum_ms;
+    uint32_t best_ms;
+    uint32_t timeouts;
+} MotorStop_Stats_t;
+
+extern MotorStop_Config_t motor_stop_config;
+extern MotorStop_Stats_t motor_stop_stats[2];     // Motor_StopMode_t ile indekslenir
+
+void MotorStop_Init(void);
+HAL_StatusTypeDef MotorStop_Begin(Motor_StopMode_t mode, uint16_t brake_ms, uint8_t strength);
+uint8_t MotorStop_IsMeasuring(void);
+void MotorStop_Tick(void);
+void MotorStop_GyroSample(float magnitude);
+void MotorStop_Task(void);
+void MotorStop_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_STOP_H__ */
@@ -0,0 +1,69 @@
+#ifndef __MOTOR_WAVE_H__
+#define __MOTOR_WAVE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* DMA ile PWM dalga formu oynatma - TIM3 update olayı DMA1 Kanal 3'ü tetikler
+ * Her PWM periyodunda DMA burst ile CCR1 (INA) ve CCR2 (INB) yazılır; compare
+ * preload'u sayesinde değer periyot sınırında geçerli olur. Tamponda periyot
+ * başına bir örnek (CCR1, CCR2 çifti) vardır. Duty'ler compare'e ana kanalın
+ * sınırı ve polaritesiyle (MLIM) MotorChannel_DutyToCompare üzerinden çevrilir:
+ * döngü dalgası Play'de, akış segmenti çalınmaya başlarken. ch->pulse çalan
+ * segmenti (döngüde ilk örneği) gösterir, bitince 0 olur.
+ *
+ * İki kip:
+ *  - Döngü: MotorWave_Load/Generate ile tampon doldurulur, MotorWave_Play ile
+ *    n kez (0 = durdurulana kadar) çalınır. Tek kesme döngü sonundadır.
+ *  - Akış: MotorWave_Queue ile segmentler (duty, açık/kapalı süre, tekrar)
+ *    kuyruğa eklenir, MotorWave_Stream tamponu iki yarı olarak çalar; DMA bir
+ *    yarıyı çalarken yarım/tam transfer kesmesi diğerini kuyruktan doldurur.
+ *    Kuyruk boşalınca çıkış sıfırlanır ve akış kendiliğinden durur.
+ * Döngü dalgasının ham duty'si ayrı tutulur, akıştan sonra yeniden yüklemek
+ * gerekmez; PWM frekansı değişirse yeniden yüklenmelidir (örnek = periyot). */
+
+#define MOTOR_WAVE_MAX_SAMPLES  512     // Tampon: PWM periyodu başına bir örnek, çift olmalı
+#define MOTOR_WAVE_QUEUE_SIZE   16      // Akış segment kuyruğu, 2'nin kuvveti olmalı
+
+typedef enum {
+    MOTOR_WAVE_IDLE = 0,
+    MOTOR_WAVE_LOOP,
+    MOTOR_WAVE_STREAM
+} MotorWave_Mode_t;
+
+typedef enum {
+    MOTOR_WAVE_SINE = 0,    // ±genlik, yön değiştirir
+    MOTOR_WAVE_SQUARE,      // 0 / genlik
+    MOTOR_WAVE_TRIANGLE,    // 0 -> genlik -> 0
+    MOTOR_WAVE_SHAPE_COUNT
+} MotorWave_Shape_t;
+
+typedef struct {
+    uint32_t started;
+    uint32_t loops;         // Tamamlanan dalga döngüsü
+    uint32_t refills;       // Akış: doldurulan yarı tampon
+    uint32_t segments;      // Akış: tüketilen segment
+    uint32_t queue_full;    // Kuyruk doluyken reddedilen segment
+    uint32_t dma_errors;
+} MotorWave_Stats_t;
+
+extern volatile MotorWave_Stats_t motor_wave_stats;
+
+HAL_StatusTypeDef MotorWave_Load(const int16_t* duty, uint16_t count, uint16_t hold);
+HAL_StatusTypeDef MotorWave_Generate(MotorWave_Shape_t shape, int32_t amplitude, uint32_t period_ms);
+HAL_StatusTypeDef MotorWave_Play(uint16_t loops);
+HAL_StatusTypeDef MotorWave_Queue(int32_t duty, uint32_t on_ms, uint32_t off_ms, uint16_t count);
+HAL_StatusTypeDef MotorWave_Stream(void);
+void MotorWave_Stop(void);
+uint8_t MotorWave_IsActive(void);
+void MotorWave_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_WAVE_H__ */
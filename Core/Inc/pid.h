@@ -0,0 +1,71 @@
+#ifndef __PID_H__
+#define __PID_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Kapalı çevrim PID - kontrol tick'inde (TIM6 ISR) koşar
+ * Geri besleme kaynağı seçilebilir: gyro hızı, açı veya harici kanal.
+ * Sensör değerleri ana döngüde güncellenir, ISR son değeri kullanır (ZOH).
+ * Türev ölçüm üzerinden alınır ve alçak geçiren filtreden geçer; integral
+ * çıkış doyumdayken aynı yönde büyümez (anti-windup). Kazançlar ve kaynak
+ * flash'ta saklanabilir (flash_store), açılışta geri yüklenir. */
+
+#define PID_OUT_LIMIT           100.0f  // Çıkış: ±% duty, işaret = yön
+#define PID_D_CUTOFF_HZ         20.0f   // Varsayılan türev filtresi kesim frekansı
+
+typedef enum {
+    PID_FB_GYRO_RATE = 0,   // dps
+    PID_FB_ANGLE,           // derece
+    PID_FB_EXTERNAL,        // Pid_SetExternal() ile beslenen kanal
+    PID_FB_RPM,             // Motor encoder hızı, dev/dk (eksen kullanılmaz)
+    PID_FB_COUNT
+} Pid_Feedback_t;
+
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+    float setpoint;
+    float d_cutoff_hz;
+    Pid_Feedback_t source;
+    uint8_t axis;           // 0=X, 1=Y, 2=Z (gyro/açı kaynakları için)
+} Pid_Config_t;
+
+typedef struct {
+    float measurement;
+    float error;
+    float integral;
+    float d_filt;
+    float output;
+    uint32_t saturated;     // Çıkışın doyumda olduğu tick sayısı
+} Pid_Status_t;
+
+extern Pid_Config_t pid_config;
+extern volatile Pid_Status_t pid_status;
+
+void Pid_Init(void);
+void Pid_Enable(uint8_t enabled);
+uint8_t Pid_IsEnabled(void);
+void Pid_SetGains(float kp, float ki, float kd);
+HAL_StatusTypeDef Pid_LoadGains(void);
+HAL_StatusTypeDef Pid_SaveGains(void);
+void Pid_SetSetpoint(float setpoint);
+void Pid_SetFeedback(Pid_Feedback_t source, uint8_t axis);
+void Pid_SetDerivativeCutoff(float hz);
+void Pid_SetExternal(float value);
+void Pid_UpdateSensors(const L3GD20_Data_t* gyro, const float angle[3]);
+float Pid_ReadFeedback(Pid_Feedback_t source, uint8_t axis);
+void Pid_Tick(void);
+void Pid_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_H__ */
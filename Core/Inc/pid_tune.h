@@ -0,0 +1,85 @@
+#ifndef __PID_TUNE_H__
+#define __PID_TUNE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Röle geri beslemeli PID ayarı (Åström-Hägglund) - kontrol tick'inde koşar
+ * PID'in kaynağı ve setpoint'i kullanılır; PID yerine motoru röle sürer:
+ * hata > +histerezis ise bias + röle, < -histerezis ise bias - röle (%).
+ * Çevrim salınıma girer; her yükselen geçişte periyot ve tepe-tepe genlik
+ * ölçülür. İlk PID_TUNE_SETTLE_CYCLES çevrim atlanır, son PID_TUNE_CYCLES
+ * çevrimin periyot ve genliği PID_TUNE_TOLERANCE içinde tutarlıysa:
+ *   Ku = 4·d / (π·√(a² - ε²)),  Tu = ortalama periyot
+ * ve seçilen kurala göre kazançlar hesaplanır, PID'e uygulanıp flash'a yazılır.
+ * Ters etkili süreçte röle negatif verilir, kazançlar da negatif çıkar. */
+
+#define PID_TUNE_SETTLE_CYCLES  2       // Geçici rejim - ölçülmeyen çevrim
+#define PID_TUNE_CYCLES         4       // Ortalaması alınan çevrim
+#define PID_TUNE_TOLERANCE      0.1f    // Periyot/genlik yayılımı / ortalama
+
+typedef enum {
+    PID_TUNE_ZN_PID = 0,        // Ziegler-Nichols PID: 0.6 Ku, Tu/2, Tu/8
+    PID_TUNE_ZN_PI,             // Ziegler-Nichols PI: 0.45 Ku, Tu/1.2
+    PID_TUNE_TL_PID,            // Tyreus-Luyben: Ku/2.2, 2.2 Tu, Tu/6.3 - daha az salınım
+    PID_TUNE_SOME_OVERSHOOT,    // Ku/3, Tu/2, Tu/3
+    PID_TUNE_NO_OVERSHOOT,      // Ku/5, Tu/2, Tu/3
+    PID_TUNE_RULE_COUNT
+} PidTune_Rule_t;
+
+typedef enum {
+    PID_TUNE_IDLE = 0,
+    PID_TUNE_RUNNING,
+    PID_TUNE_DONE,
+    PID_TUNE_FAILED
+} PidTune_State_t;
+
+typedef enum {
+    PID_TUNE_FAIL_NONE = 0,
+    PID_TUNE_FAIL_TIMEOUT,      // Tutarlı salınım yok
+    PID_TUNE_FAIL_ABORTED,      // Durduruldu veya başka kaynak/aşırı akım
+    PID_TUNE_FAIL_AMPLITUDE     // Genlik histerezisten küçük
+} PidTune_Fail_t;
+
+typedef struct {
+    float relay;                // Röle genliği, % duty (işaret = süreç yönü)
+    float bias;                 // Çalışma noktası, % duty
+    float hysteresis;           // Geri besleme biriminde
+    PidTune_Rule_t rule;
+    uint16_t timeout_ms;
+} PidTune_Config_t;
+
+typedef struct {
+    PidTune_State_t state;
+    PidTune_Fail_t fail;
+    uint8_t cycles;             // Tamamlanan çevrim
+    float period_s;             // Son çevrim
+    float amplitude;            // Son çevrim, tepe genliği
+    float ku;
+    float tu;
+    float kp;
+    float ki;
+    float kd;
+} PidTune_Status_t;
+
+extern PidTune_Config_t pid_tune_config;
+extern volatile PidTune_Status_t pid_tune_status;
+
+void PidTune_Init(void);
+HAL_StatusTypeDef PidTune_Start(float relay, float bias, float hysteresis,
+                                PidTune_Rule_t rule, uint16_t timeout_ms);
+void PidTune_Stop(void);
+uint8_t PidTune_IsRunning(void);
+void PidTune_Tick(void);
+void PidTune_Task(void);
+void PidTune_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_TUNE_H__ */
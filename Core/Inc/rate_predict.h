@@ -0,0 +1,70 @@
+#ifndef __RATE_PREDICT_H__
+#define __RATE_PREDICT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "pid.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Gecikme telafisi - gyro hızını türeviyle PWM'in etkin olacağı ana öteler
+ * Boru hattı gecikmesi: örnek anından (DWT zaman damgası) PWM compare'in
+ * yüklendiği TIM3 update'ine kadar geçen süre ölçülür, buna horizon_ms
+ * (sensör filtresi grup gecikmesi gibi ölçülemeyen kısım) eklenir:
+ *   ileri = gain · ẏ · (yaş + PWM bekleme + horizon)
+ * ẏ örnekler arası farktan, gerçek dt ile, alçak geçiren filtreli hesaplanır.
+ * PID'de RATE kaynağında hız, ANGLE kaynağında açı (türevi hız) ötelenir.
+ * Ölçüm kipi: pencere boyunca her örneğin çıkışa ulaşma gecikmesi (ham)
+ * ölçülür. Her çıkışa giden tahmin, sonraki gerçek örnekler arasında doğrusal
+ * ara değerlenen sinyalle çeyrek örnek adımlı kaydırmalarda karşılaştırılır:
+ *  - öncü: RMS farkın en küçük olduğu kaydırma (parabolle alt-adım, 0'da da).
+ *    Düzgün harekette gain · (yaş + horizon)'a yaklaşır; türev gürültüsü,
+ *    filtre gecikmesi ve ivmelenme onu kısaltır. Telafili etkin gecikme =
+ *    ham - öncü, yani tahminin gerçekte kaç ms ileriyi gösterdiği.
+ *  - hedef RMS: tahminin amaçlandığı anda (ortalama yaş + horizon) gerçek
+ *    sinyalden farkı - kazançtan bağımsız asıl doğruluk ölçüsü; g = 0 ile
+ *    telafisiz hata aynı noktada alınır.
+ * Ölçüm için eksen hareket etmeli. */
+
+#define RATE_PREDICT_LAGS       6       // Öncü araması: 0..LAGS-1 örnek
+#define RATE_PREDICT_SUBSTEPS   4       // Örnek başına ara değer kaydırması
+#define RATE_PREDICT_BINS       ((RATE_PREDICT_LAGS - 1) * RATE_PREDICT_SUBSTEPS + 1)
+
+typedef struct {
+    float gain;                 // 0 = kapalı
+    float horizon_ms;           // Ölçülen gecikmeye eklenen sabit kısım
+    float d_cutoff_hz;          // Türev filtresi
+} RatePredict_Config_t;
+
+typedef struct {
+    uint32_t samples;           // Çıkışa ulaşan örnek
+    float raw_ms;               // Ortalama örnek -> PWM gecikmesi
+    float raw_max_ms;
+    float lead_ms;              // Tahminin kazandırdığı süre
+    float err_raw;              // Öncü 0: tahmin ile aynı örnek arasındaki RMS fark
+    float err_comp;             // En iyi öncüde tahmin ile sonraki gerçek değer arasındaki RMS fark
+    float target_ms;            // Tahminin amaçlandığı ileri süre (ortalama yaş + horizon)
+    float err_target;           // Bu anda ara değerlenmiş gerçek sinyalle RMS fark
+    uint8_t axis;
+} RatePredict_Result_t;
+
+extern RatePredict_Config_t rate_predict_config;
+extern RatePredict_Result_t rate_predict_result;
+
+void RatePredict_Init(void);
+HAL_StatusTypeDef RatePredict_Configure(float gain, float horizon_ms, float d_cutoff_hz);
+void RatePredict_Update(const L3GD20_Data_t* gyro);
+float RatePredict_Lead(Pid_Feedback_t source, uint8_t axis);
+void RatePredict_MarkOutput(void);
+HAL_StatusTypeDef RatePredict_Measure(uint16_t window_ms, uint8_t axis);
+void RatePredict_Task(void);
+void RatePredict_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RATE_PREDICT_H__ */
@@ -0,0 +1,75 @@
+#ifndef __SAMPLE_SYNC_H__
+#define __SAMPLE_SYNC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* PWM'e senkron sensör okuma - SPI/I2C trafiğini PWM fazına kilitler
+ * Örnek zamanı geldiğinde okuma PWM periyodunun sabit bir fazında başlar:
+ *  - ON:    TIM3 CC4 eşleşmesi (iletim ortası - akım ölçümünün ADC tetiği,
+ *           duty ile birlikte kayar)
+ *  - PHASE: periyodun sabit yüzdesi
+ * DİKKAT: sadece veri yolu işleminin zamanı kayar. L3GD20 ve LSM303 kendi
+ * iç saatleriyle (ODR) örnekler; dışarıdan saat/tetik girişleri yoktur, bu
+ * yüzden okunan değerin alındığı an PWM fazına bağlı değildir ve ODR ile PWM
+ * kilitlenemez. Kip, anahtarlama kenarlarının SPI/I2C hatlarına (CS, saat,
+ * ACK) binmesini ve okuma ile motor yazımı arasındaki gecikmeyi etkiler;
+ * sensörün kendi örneğindeki anahtarlama gürültüsünü değiştirmez. NOISE
+ * karşılaştırması bu yüzden ancak veri yolu kaynaklı etkiyi gösterebilir.
+ * Bekleme TIM3 sayacından hesaplanır ve SAMPLE_SYNC_MAX_WAIT_US ile sınırlıdır.
+ * PWM periyodu bu sınırdan uzunsa (~10 kHz altı) SYNC 1/2 ve NOISE reddedilir.
+ * Kip açıkken PWM yavaşlatılırsa okuma beklemeden yapılır, atlanmış sayılır
+ * ve gürültü kipinde asenkron gruba yazılır - karşılaştırma sessizce
+ * asenkronla asenkronu ölçmez.
+ * Gürültü kipi: hareketsiz kart, motor dönerken örnekler sırayla senkron/
+ * asenkron alınır, her grup için eksen başına RMS gürültü (standart sapma). */
+
+#define SAMPLE_SYNC_MAX_WAIT_US 100     // En uzun faz beklemesi (20 kHz'de iki periyot)
+
+typedef enum {
+    SAMPLE_SYNC_OFF = 0,        // Asenkron (HAL_GetTick zamanlaması)
+    SAMPLE_SYNC_ON,             // CC4 - iletim ortası
+    SAMPLE_SYNC_PHASE,          // Periyodun phase_pct yüzdesi
+    SAMPLE_SYNC_MODE_COUNT
+} SampleSync_Mode_t;
+
+typedef struct {
+    SampleSync_Mode_t mode;
+    uint8_t phase_pct;          // 0..99, PHASE kipinde
+} SampleSync_Config_t;
+
+typedef struct {
+    uint32_t waits;
+    uint32_t skipped;           // Hedef faz sınırdan uzak - beklenmedi
+    uint32_t wait_max_cycles;
+    uint32_t wait_sum_cycles;
+} SampleSync_Stats_t;
+
+typedef struct {
+    uint32_t n;                 // Gyro örneği
+    uint32_t n_acc;             // İvme okuması başarılı örnek
+    float mean[6];              // gyro x/y/z (dps), ivme x/y/z (g)
+    float m2[6];                // Welford kareler toplamı
+} SampleSync_Noise_t;
+
+extern SampleSync_Config_t sample_sync_config;
+extern SampleSync_Stats_t sample_sync_stats;
+
+void SampleSync_Init(void);
+HAL_StatusTypeDef SampleSync_Configure(SampleSync_Mode_t mode, uint8_t phase_pct);
+void SampleSync_Wait(void);
+HAL_StatusTypeDef SampleSync_NoiseStart(uint16_t window_ms);
+void SampleSync_NoiseSample(const L3GD20_Data_t* gyro, const float acc[3], uint8_t acc_ok);
+void SampleSync_Task(void);
+void SampleSync_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SAMPLE_SYNC_H__ */
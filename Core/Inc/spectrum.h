@@ -0,0 +1,55 @@
+#ifndef __SPECTRUM_H__
+#define __SPECTRUM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "L3GD20.h"
+#include <stdint.h>
+
+/* Gyro titreşim spektrumu - cihaz üzerinde gerçek FFT
+ * SPECTRUM_N gerçek örnek, N/2 noktalı kompleks FFT'ye paketlenir (radix-4 geçişler,
+ * log2 tekse bir radix-2 geçiş) ve split adımıyla gerçek spektruma açılır.
+ * Hesap ana döngüde adım adım yapılır (her çağrıda bir geçiş), böylece örnekleme
+ * periyodunu bozmaz. Adım başına ve toplam cycle maliyeti raporlanır. */
+
+#define SPECTRUM_N              256     // 256 veya 512 gerçek örnek
+#define SPECTRUM_M              (SPECTRUM_N / 2)
+#define SPECTRUM_PEAKS          3       // Raporlanan tepe sayısı
+#define SPECTRUM_BANDS          4       // Bant enerjisi sayısı
+
+// Bant sınırları (Hz) - SPECTRUM_BANDS + 1 değer, son sınır Nyquist ile kırpılır
+#define SPECTRUM_BAND_EDGES_HZ  { 1.0f, 5.0f, 15.0f, 30.0f, 500.0f }
+
+typedef enum {
+    SPECTRUM_AXIS_X = 0,
+    SPECTRUM_AXIS_Y,
+    SPECTRUM_AXIS_Z
+} Spectrum_Axis_t;
+
+typedef struct {
+    float fs_hz;                        // Zaman damgalarından ölçülen örnekleme hızı
+    float peak_hz[SPECTRUM_PEAKS];
+    float peak_amp[SPECTRUM_PEAKS];     // dps (tepe genliği)
+    float band_power[SPECTRUM_BANDS];   // dps²
+    uint32_t cycles_total;              // Bir çerçevenin toplam hesap maliyeti
+    uint32_t cycles_max_step;           // En pahalı tek adım (ana döngü gecikmesi)
+    uint32_t frames;
+    uint32_t overruns;                  // Hesap bitmeden dolan yakalama tamponu
+} Spectrum_Result_t;
+
+extern Spectrum_Result_t spectrum_result;
+
+void Spectrum_Init(void);
+void Spectrum_SetAxis(Spectrum_Axis_t axis);
+void Spectrum_AddSample(const L3GD20_Data_t* data);
+void Spectrum_Task(void);
+void Spectrum_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPECTRUM_H__ */
@@ -0,0 +1,58 @@
+#ifndef __SPEED_PROFILE_H__
+#define __SPEED_PROFILE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Jerk sınırlı hız profili (trapez / S-curve)
+ * Hızlanma, sabit hız ve yavaşlama 7 faza bölünür (jerk+, sabit ivme, jerk-,
+ * seyir, jerk-, sabit ivme, jerk+). Faz sınırları ve başlangıç değerleri
+ * planlama sırasında tick cinsinden hesaplanır; tick başına değerlendirme
+ * Q32 sabit noktada sadece toplama/kaydırma yapar (bölme yok, ISR'a uygun).
+ * Modül HAL'e bağlı değildir. SpeedProfile_Reference() plandan bağımsızdır:
+ * parametrelerden sürekli zamanda kapalı form (tick yuvarlaması yok);
+ * Tests/test_speed_profile.c host'ta ikisini karşılaştırır. */
+
+#define SPEED_PROFILE_PHASES    7
+
+typedef struct {
+    float v_start;          // Çıkış birimi (örn. compare değeri)
+    float v_peak;
+    float v_end;
+    float accel;            // Birim/s, > 0
+    float jerk;             // Birim/s², 0 = trapez (sonsuz jerk)
+    float cruise_s;         // v_peak'te kalma süresi
+} SpeedProfile_Params_t;
+
+typedef struct {
+    uint32_t ticks[SPEED_PROFILE_PHASES];
+    int64_t vel_q[SPEED_PROFILE_PHASES];    // Faz başı hız (Q32, birim)
+    int64_t accel_q[SPEED_PROFILE_PHASES];  // Faz başı ivme (Q32, birim/tick)
+    int64_t jerk_q[SPEED_PROFILE_PHASES];   // Q32, birim/tick²
+    int32_t v_end;
+    uint32_t total_ticks;
+    float tick_hz;
+} SpeedProfile_Plan_t;
+
+typedef struct {
+    const SpeedProfile_Plan_t* plan;
+    uint8_t phase;
+    uint32_t tick;
+    int64_t v_q;
+    int64_t a_q;
+} SpeedProfile_State_t;
+
+int SpeedProfile_Plan(SpeedProfile_Plan_t* plan, const SpeedProfile_Params_t* params, float tick_hz);
+void SpeedProfile_Begin(SpeedProfile_State_t* state, const SpeedProfile_Plan_t* plan);
+uint8_t SpeedProfile_Step(SpeedProfile_State_t* state, int32_t* out);
+float SpeedProfile_Reference(const SpeedProfile_Params_t* params, float t);
+float SpeedProfile_Duration(const SpeedProfile_Plan_t* plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPEED_PROFILE_H__ */
@@ -0,0 +1,27 @@
+#ifndef __TIMEBASE_H__
+#define __TIMEBASE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* Donanım zaman damgası - DWT cycle counter (72MHz'de ~59s'de taşar,
+ * uint32_t farkları taşmaya karşı güvenlidir) */
+
+void Timebase_Init(void);
+float Timebase_CyclesToSeconds(uint32_t cycles);
+uint32_t Timebase_CyclesToUs(uint32_t cycles);
+
+static inline uint32_t Timebase_Cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMEBASE_H__ */
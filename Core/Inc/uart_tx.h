@@ -0,0 +1,46 @@
+#ifndef __UART_TX_H__
+#define __UART_TX_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdint.h>
+
+/* USART2 gönderim halka tamponu - DMA1 Kanal 7 ile boşaltılır
+ * SendDebugMessage mesajı tampona kopyalayıp hemen döner; DMA bitince
+ * (HAL_UART_TxCpltCallback) sıradaki bitişik parça başlatılır, tampon boşalana
+ * kadar aktarımlar zincirlenir. Sığmayan mesaj bütün olarak atılır (satır
+ * bölünmez) ve atılan byte sayılır - örnekleme döngüsü UART'ı beklemez.
+ * 115200 baud ~11.5 kB/s: 2 kB tampon ~175 ms'lik çıkışı karşılar.
+ * İkili döküm (IDDUMP) gibi kaybolmaması gereken veri WriteBlocking ile
+ * yer açılmasını bekler. */
+
+#define UART_TX_BUF_SIZE        2048    // 2'nin kuvveti olmalı
+#define UART_TX_BLOCK_TIMEOUT_MS 200    // WriteBlocking: ilerleme olmazsa vazgeç
+
+typedef struct {
+    uint32_t bytes;             // DMA'ya verilen
+    uint32_t transfers;         // DMA aktarımı
+    uint32_t dropped_bytes;     // Tampon dolu - atılan
+    uint32_t drops;             // Atılan mesaj
+    uint32_t errors;            // Başlatılamayan / hatalı aktarım
+    uint16_t high_water;        // En yüksek doluluk (byte)
+} UartTx_Stats_t;
+
+extern UartTx_Stats_t uart_tx_stats;
+
+void UartTx_Init(void);
+HAL_StatusTypeDef UartTx_Write(const uint8_t* data, uint16_t len);
+HAL_StatusTypeDef UartTx_WriteBlocking(const uint8_t* data, uint16_t len);
+HAL_StatusTypeDef UartTx_Flush(uint32_t timeout_ms);
+uint16_t UartTx_Pending(void);
+void UartTx_Resume(void);
+void UartTx_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_TX_H__ */
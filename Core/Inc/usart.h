@@ -11,6 +11,8 @@ extern "C" {
 
 /* Exported variables -------------------------------------------------------*/
 extern UART_HandleTypeDef huart2;
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern DMA_HandleTypeDef hdma_usart2_tx;
 
 /* Exported functions prototypes ---------------------------------------------*/
 void MX_USART2_UART_Init(void);
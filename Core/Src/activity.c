@@ -0,0 +1,286 @@
+#include "activity.h"
+#include "spectrum.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char* const activity_names[ACTIVITY_LABEL_COUNT] = {
+    "IDLE", "HANDLING", "TRANSPORT", "VIBRATION"
+};
+
+// Varsayılan ağaç
+static const Activity_Config_t activity_default_config = {
+    .node_count = 6,
+    .min_windows = 2,
+    .window_ms = 1000,
+    .nodes = {
+        /* 0 */ { ACTIVITY_FEAT_GYRO_RMS, 1, 2, 2.0f },
+        /* 1 */ { ACTIVITY_FEAT_ACC_RMS, ACTIVITY_LEAF(ACTIVITY_IDLE), 3, 0.02f },
+        /* 2 */ { ACTIVITY_FEAT_ZC_RATE, 4, 5, 6.0f },
+        /* 3 */ { ACTIVITY_FEAT_DOM_FREQ, ACTIVITY_LEAF(ACTIVITY_TRANSPORT), ACTIVITY_LEAF(ACTIVITY_VIBRATION), 8.0f },
+        /* 4 */ { ACTIVITY_FEAT_GYRO_RMS, ACTIVITY_LEAF(ACTIVITY_TRANSPORT), ACTIVITY_LEAF(ACTIVITY_HANDLING), 10.0f },
+        /* 5 */ { ACTIVITY_FEAT_DOM_FREQ, ACTIVITY_LEAF(ACTIVITY_HANDLING), ACTIVITY_LEAF(ACTIVITY_VIBRATION), 8.0f },
+    }
+};
+
+typedef struct {
+    uint32_t start_ms;
+    uint32_t n;
+    float gyro_sq;          // Σ|ω|²
+    uint32_t acc_n;         // İvmesi okunan örnek
+    float acc_ref;          // Penceredeki ilk |a| - toplamlar buna göre (kayıpsız varyans)
+    float acc_sum;          // Σ(|a| - ref)
+    float acc_sq;           // Σ(|a| - ref)²
+    uint32_t crossings;
+    float mean[3];          // Sıfır geçişi için yavaş EWMA ortalama
+    int8_t sign[3];
+} Activity_Acc_t;
+
+static Activity_Config_t activity_config;
+static Activity_Acc_t acc_state;
+static float features[ACTIVITY_FEAT_COUNT];
+static uint8_t acc_valid = 0;           // Son pencerede ivme özelliği ölçüldü
+static Activity_Label_t current_label = ACTIVITY_IDLE;
+static Activity_Label_t candidate_label = ACTIVITY_IDLE;
+static uint8_t candidate_count = 0;
+
+/**
+ * @brief Varsayılan ağacı yükler ve pencereyi sıfırlar
+ */
+void Activity_Init(void)
+{
+    activity_config = activity_default_config;
+    memset(&acc_state, 0, sizeof(acc_state));
+    acc_state.start_ms = HAL_GetTick();
+    current_label = ACTIVITY_IDLE;
+    candidate_label = ACTIVITY_IDLE;
+    candidate_count = 0;
+}
+
+Activity_Label_t Activity_GetLabel(void)
+{
+    return current_label;
+}
+
+const char* Activity_Name(Activity_Label_t label)
+{
+    return (label < ACTIVITY_LABEL_COUNT) ? activity_names[label] : "?";
+}
+
+static Activity_Label_t Activity_Classify(void)
+{
+    int8_t node = 0;
+
+    // Ağaç derinliği düğüm sayısını geçemez - bozuk config'de sonsuz döngü olmasın
+    for (uint8_t depth = 0; depth < activity_config.node_count; depth++)
+    {
+        const Activity_Node_t* n = &activity_config.nodes[node];
+        uint8_t below = (n->feature == ACTIVITY_FEAT_ACC_RMS && !acc_valid) ||
+                        features[n->feature] < n->threshold;
+        node = below ? n->left : n->right;
+        if (node < 0) return (Activity_Label_t)(-node - 1);
+    }
+    return current_label;
+}
+
+static void Activity_CloseWindow(uint32_t now_ms)
+{
+    Activity_Acc_t* a = &acc_state;
+    float window_s = (float)(now_ms - a->start_ms) / 1000.0f;
+    char msg[64];
+
+    if (a->n == 0 || window_s <= 0.0f) return;
+
+    features[ACTIVITY_FEAT_GYRO_RMS] = sqrtf(a->gyro_sq / (float)a->n);
+    // Ortalama çıkarılmış |a| varyansı: ölçek hatası ve 1g sabit kısmı düşer
+    acc_valid = a->acc_n > 0;
+    features[ACTIVITY_FEAT_ACC_RMS] = 0.0f;
+    if (acc_valid)
+    {
+        float mean = a->acc_sum / (float)a->acc_n;
+        float var = a->acc_sq / (float)a->acc_n - mean * mean;
+        features[ACTIVITY_FEAT_ACC_RMS] = (var > 0.0f) ? sqrtf(var) : 0.0f;
+    }
+    features[ACTIVITY_FEAT_ZC_RATE] = (float)a->crossings / window_s;
+
+    // Baskın frekans/bant - son spektrum çerçevesinden
+    features[ACTIVITY_FEAT_DOM_FREQ] = 0.0f;
+    features[ACTIVITY_FEAT_DOM_BAND] = 0.0f;
+    if (spectrum_result.frames > 0 && spectrum_result.peak_amp[0] > ACTIVITY_MIN_PEAK_DPS)
+    {
+        float best = 0.0f;
+        features[ACTIVITY_FEAT_DOM_FREQ] = spectrum_result.peak_hz[0];
+        for (int b = 0; b < SPECTRUM_BANDS; b++)
+        {
+            if (spectrum_result.band_power[b] > best)
+            {
+                best = spectrum_result.band_power[b];
+                features[ACTIVITY_FEAT_DOM_BAND] = (float)b;
+            }
+        }
+    }
+
+    Activity_Label_t label = Activity_Classify();
+
+    // Histerezis: yeni etiket min_windows pencere boyunca sürmeli
+    if (label == current_label)
+    {
+        candidate_count = 0;
+    }
+    else
+    {
+        if (label != candidate_label)
+        {
+            candidate_label = label;
+            candidate_count = 0;
+        }
+        if (++candidate_count >= activity_config.min_windows)
+        {
+            sprintf(msg, "Activity[%s t:%lu prev:%s]\r\n",
+                    activity_names[label], now_ms, activity_names[current_label]);
+            SendDebugMessage(msg);
+            current_label = label;
+            candidate_count = 0;
+        }
+    }
+
+    a->n = 0;
+    a->gyro_sq = 0.0f;
+    a->acc_n = 0;
+    a->acc_sum = 0.0f;
+    a->acc_sq = 0.0f;
+    a->crossings = 0;
+    a->start_ms = now_ms;
+}
+
+/**
+ * @brief Örnek başına çağrılır - özellikleri artımlı toplar
+ */
+void Activity_Update(const L3GD20_Data_t* gyro, const float acc[3], uint8_t acc_ok, uint32_t now_ms)
+{
+    Activity_Acc_t* a = &acc_state;
+    float v[3] = {gyro->x, gyro->y, gyro->z};
+
+    if (now_ms - a->start_ms >= activity_config.window_ms)
+    {
+        Activity_CloseWindow(now_ms);
+    }
+
+    a->n++;
+    a->gyro_sq += gyro->magnitude * gyro->magnitude;
+
+    if (acc_ok)
+    {
+        float m = sqrtf(acc[0] * acc[0] + acc[1] * acc[1] + acc[2] * acc[2]);
+        if (a->acc_n == 0) a->acc_ref = m;
+        float d = m - a->acc_ref;
+        a->acc_n++;
+        a->acc_sum += d;
+        a->acc_sq += d * d;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        float d = v[i] - a->mean[i];
+        a->mean[i] += d * (1.0f / 64.0f);
+
+        int8_t s = a->sign[i];
+        if (d > ACTIVITY_ZC_HYST_DPS) s = 1;
+        else if (d < -ACTIVITY_ZC_HYST_DPS) s = -1;
+        if (s != a->sign[i])
+        {
+            if (a->sign[i] != 0) a->crossings++;
+            a->sign[i] = s;
+        }
+    }
+}
+
+static uint16_t Activity_Crc16(const uint8_t* data, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;   // CRC-16/CCITT-FALSE
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Config blob'unu doğrular ve uygular
+ * Format (little endian):
+ *   "ACT1" | node_count | min_windows | window_ms(u16)
+ *   node_count x { feature | left(i8) | right(i8) | 0 | threshold(float) }
+ *   crc16 (CCITT-FALSE, önceki tüm byte'lar)
+ */
+HAL_StatusTypeDef Activity_LoadConfig(const uint8_t* blob, uint16_t len)
+{
+    Activity_Config_t cfg;
+
+    if (len < ACTIVITY_BLOB_HEADER + 2 || memcmp(blob, ACTIVITY_BLOB_MAGIC, 4) != 0)
+    {
+        return HAL_ERROR;
+    }
+
+    cfg.node_count = blob[4];
+    cfg.min_windows = blob[5];
+    cfg.window_ms = (uint16_t)(blob[6] | (blob[7] << 8));
+
+    if (cfg.node_count == 0 || cfg.node_count > ACTIVITY_MAX_NODES || cfg.window_ms == 0 ||
+        len != ACTIVITY_BLOB_HEADER + cfg.node_count * ACTIVITY_BLOB_NODE + 2)
+    {
+        return HAL_ERROR;
+    }
+
+    if (Activity_Crc16(blob, len - 2) != (uint16_t)(blob[len - 2] | (blob[len - 1] << 8)))
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint8_t i = 0; i < cfg.node_count; i++)
+    {
+        const uint8_t* p = &blob[ACTIVITY_BLOB_HEADER + i * ACTIVITY_BLOB_NODE];
+        Activity_Node_t* n = &cfg.nodes[i];
+
+        n->feature = p[0];
+        n->left = (int8_t)p[1];
+        n->right = (int8_t)p[2];
+        memcpy(&n->threshold, &p[4], sizeof(float));
+
+        // Düğüm referansları aralıkta, yapraklar geçerli etiket olmalı
+        if (n->feature >= ACTIVITY_FEAT_COUNT ||
+            n->left >= cfg.node_count || n->right >= cfg.node_count ||
+            n->left < ACTIVITY_LEAF(ACTIVITY_LABEL_COUNT - 1) ||
+            n->right < ACTIVITY_LEAF(ACTIVITY_LABEL_COUNT - 1))
+        {
+            return HAL_ERROR;
+        }
+    }
+
+    activity_config = cfg;
+    candidate_count = 0;
+    return HAL_OK;
+}
+
+/**
+ * @brief Son pencerenin özelliklerini yazar (ağaç ayarı için)
+ */
+void Activity_ReportFeatures(void)
+{
+    char msg[128];
+    char acc_str[12];
+
+    if (acc_valid) sprintf(acc_str, "%.3f", features[ACTIVITY_FEAT_ACC_RMS]);
+    else strcpy(acc_str, "n/a");
+
+    sprintf(msg, "ActFeat[%s G:%.2f A:%s ZC:%.1f F:%.1f B:%d]\r\n",
+            activity_names[current_label],
+            features[ACTIVITY_FEAT_GYRO_RMS], acc_str,
+            features[ACTIVITY_FEAT_ZC_RATE], features[ACTIVITY_FEAT_DOM_FREQ],
+            (int)features[ACTIVITY_FEAT_DOM_BAND]);
+    SendDebugMessage(msg);
+}
@@ -0,0 +1,89 @@
+/* Includes ------------------------------------------------------------------*/
+#include "adc.h"
+
+/* USER CODE BEGIN 0 */
+/* HAL ADC kaynakları Drivers altında yok - ADC1 CMSIS register'larıyla kurulur,
+ * DMA için HAL DMA kullanılır. */
+/* USER CODE END 0 */
+
+DMA_HandleTypeDef hdma_adc1;
+
+/* ADC1 init function - TIM3_CC4 tetikli tek kanal, dairesel DMA, analog watchdog 1 */
+void MX_ADC1_Init(uint16_t* buffer, uint16_t length)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  /* Peripheral clock enable - senkron HCLK/1 (AHB bölücü 1 olmalı) */
+  __HAL_RCC_ADC12_CLK_ENABLE();
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  ADC12_COMMON->CCR = (ADC12_COMMON->CCR & ~ADC_CCR_CKMODE) | ADC_CCR_CKMODE_0;
+
+  /**ADC1 GPIO Configuration
+  PA1     ------> ADC1_IN2 (akım algılama)
+  */
+  GPIO_InitStruct.Pin = CURRENT_SENSE_PIN;
+  GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  HAL_GPIO_Init(CURRENT_SENSE_GPIO_Port, &GPIO_InitStruct);
+
+  /* Voltaj regülatörü: 10 -> 00 -> 01, en az 10us bekle */
+  ADC1->CR &= ~ADC_CR_ADVREGEN;
+  ADC1->CR |= ADC_CR_ADVREGEN_0;
+  HAL_Delay(1);
+
+  /* Tek uçlu kalibrasyon */
+  ADC1->CR &= ~ADC_CR_ADCALDIF;
+  ADC1->CR |= ADC_CR_ADCAL;
+  while (ADC1->CR & ADC_CR_ADCAL)
+  {
+  }
+
+  /* Örnekleme 19.5 + 12.5 ADC saati = 0.44us @72MHz */
+  ADC1->SMPR1 = (ADC1->SMPR1 & ~ADC_SMPR1_SMP2) | (4U << ADC_SMPR1_SMP2_Pos);
+  ADC1->SQR1 = (ADC1_SENSE_CHANNEL << ADC_SQR1_SQ1_Pos);     // L=0: tek dönüşüm
+
+  /* 12 bit sağa hizalı, TIM3_CC4 yükselen kenarı, DMA dairesel
+   * AWD1 sadece algılama kanalında - eşik CurrentSense tarafından TR1'e yazılır */
+  ADC1->CFGR = ADC_CFGR_EXTEN_0 | (ADC1_EXTSEL_TIM3_CC4 << ADC_CFGR_EXTSEL_Pos) |
+               ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | ADC_CFGR_OVRMOD |
+               ADC_CFGR_AWD1SGL | ADC_CFGR_AWD1EN | (ADC1_SENSE_CHANNEL << ADC_CFGR_AWD1CH_Pos);
+  ADC1->TR1 = (0xFFFU << ADC_TR1_HT1_Pos);
+
+  /* ADC1 DMA Init - DMA1 Channel1, sonuçlar örnek tamponuna dairesel */
+  hdma_adc1.Instance = DMA1_Channel1;
+  hdma_adc1.Init.Direction = DMA_PERIPH_TO_MEMORY;
+  hdma_adc1.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_adc1.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma_adc1.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+  hdma_adc1.Init.Mode = DMA_CIRCULAR;
+  hdma_adc1.Init.Priority = DMA_PRIORITY_HIGH;
+  if (HAL_DMA_Init(&hdma_adc1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  if (HAL_DMA_Start(&hdma_adc1, (uint32_t)&ADC1->DR, (uint32_t)buffer, length) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /* Etkinleştir, hazır olunca tetik beklemeye başla */
+  ADC1->ISR = ADC_ISR_ADRDY;
+  ADC1->CR |= ADC_CR_ADEN;
+  while (!(ADC1->ISR & ADC_ISR_ADRDY))
+  {
+  }
+
+  /* ADC1 interrupt Init - analog watchdog aşırı akım kesmesi
+     Tek preempt 0 kesmesi: diğer ISR'ler (1) çalışırken de hemen girer */
+  ADC1->ISR = ADC_ISR_AWD1;
+  ADC1->IER = ADC_IER_AWD1IE;
+  HAL_NVIC_SetPriority(ADC1_2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
+
+  ADC1->CR |= ADC_CR_ADSTART;
+}
+
+/* USER CODE BEGIN 1 */
+
+/* USER CODE END 1 */
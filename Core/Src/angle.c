@@ -0,0 +1,88 @@
+#include "angle.h"
+#include "timebase.h"
+#include <stdio.h>
+
+Angle_t angle_state;
+
+/**
+ * @brief Açıları ve drift istatistiklerini sıfırlar (ARST komutu)
+ */
+void Angle_Reset(void)
+{
+    memset(&angle_state, 0, sizeof(angle_state));
+    angle_state.dt_min_s = ANGLE_DT_MAX_S;
+}
+
+/**
+ * @brief Yeni örneği trapez kuralıyla entegre eder
+ * @param data: Bias düzeltilmiş gyro verisi (timestamp dahil)
+ * @param still: 1=Kart hareketsiz (bu süredeki açı değişimi drift sayılır)
+ */
+void Angle_Update(const L3GD20_Data_t* data, uint8_t still)
+{
+    Angle_t* a = &angle_state;
+    float rate[3] = {data->x, data->y, data->z};
+
+    if (a->has_last)
+    {
+        float dt = Timebase_CyclesToSeconds(data->timestamp - a->last_ts);
+
+        if (dt > ANGLE_DT_MAX_S)
+        {
+            a->gaps++;
+        }
+        else
+        {
+            if (dt < a->dt_min_s) a->dt_min_s = dt;
+            if (dt > a->dt_max_s) a->dt_max_s = dt;
+
+            for (int i = 0; i < 3; i++)
+            {
+                float d = 0.5f * (rate[i] + a->last_rate[i]) * dt;
+                a->angle[i] += d;
+                if (still) a->still_angle[i] += d;
+            }
+            if (still) a->still_time_s += dt;
+            a->elapsed_s += dt;
+        }
+    }
+
+    a->last_rate[0] = rate[0];
+    a->last_rate[1] = rate[1];
+    a->last_rate[2] = rate[2];
+    a->last_ts = data->timestamp;
+    a->has_last = 1;
+}
+
+/**
+ * @brief Hareketsiz sürelerde biriken açıdan drift tahmini (derece/dakika)
+ */
+void Angle_GetDriftPerMinute(float drift[3])
+{
+    for (int i = 0; i < 3; i++)
+    {
+        drift[i] = (angle_state.still_time_s > 0.0f)
+                 ? angle_state.still_angle[i] * 60.0f / angle_state.still_time_s
+                 : 0.0f;
+    }
+}
+
+/**
+ * @brief Açı, drift ve dt istatistiğini UART'a yazar
+ */
+void Angle_Report(void)
+{
+    char msg[160];
+    float drift[3];
+
+    Angle_GetDriftPerMinute(drift);
+    sprintf(msg, "Angle[X:%.2f Y:%.2f Z:%.2f] Drift[X:%.3f Y:%.3f Z:%.3f]/min T:%.1fs dt:%.2f-%.2fms\r\n",
+            angle_state.angle[0], angle_state.angle[1], angle_state.angle[2],
+            drift[0], drift[1], drift[2], angle_state.elapsed_s,
+            angle_state.dt_min_s * 1000.0f, angle_state.dt_max_s * 1000.0f);
+    SendDebugMessage(msg);
+
+    // dt aralığı rapor periyodu başına tutulur
+    angle_state.dt_min_s = ANGLE_DT_MAX_S;
+    angle_state.dt_max_s = 0.0f;
+}
@@ -0,0 +1,897 @@
+#include "command.h"
+#include "motor.h"
+#include "usart.h"
+#include "angle.h"
+#include "gyro_bias.h"
+#include "motion_event.h"
+#include "motion_stats.h"
+#include "spectrum.h"
+#include "activity.h"
+#include "pid.h"
+#include "motor_wave.h"
+#include "motor_curve.h"
+#include "encoder.h"
+#include "current_sense.h"
+#include "motor_stop.h"
+#include "motor_output.h"
+#include "control.h"
+#include "motor_profile.h"
+#include "motor_queue.h"
+#include "motor_ident.h"
+#include "pid_tune.h"
+#include "rate_predict.h"
+#include "sample_sync.h"
+#include "uart_tx.h"
+#include "timebase.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+extern char debugMsg[UART_BUFFER_SIZE];  // From main.c
+extern uint8_t rxBuffer[RX_BUFFER_SIZE]; // From main.c
+
+static uint16_t rx_pos = 0;                // rxBuffer'da işlenen son konum (DMA halkası)
+static char rx_line[CMD_LINE_SIZE];       // ISR'da biriken satır
+static uint8_t rx_len = 0;
+static uint8_t rx_overflow = 0;           // Satır CMD_LINE_SIZE'ı aştı - sonlandırıcıda atılır
+
+// Tamamlanan satırlar - ISR yazar, Command_Poll okur
+static char cmd_queue[CMD_QUEUE_DEPTH][CMD_LINE_SIZE];
+static uint32_t cmd_stamp[CMD_QUEUE_DEPTH];   // Satır sonu anı (DWT)
+static volatile uint8_t cmd_head = 0;
+static volatile uint8_t cmd_tail = 0;
+static char cmd_line[CMD_LINE_SIZE];      // ProcessCommand'in işlediği satır
+static volatile uint32_t command_dropped = 0;
+static volatile uint32_t command_too_long = 0;
+static volatile uint32_t rx_events = 0;
+static volatile uint32_t rx_errors = 0;
+static uint32_t command_count = 0;
+static uint32_t latency_max_cycles = 0;
+
+// ACFG ile parça parça gelen sınıflandırıcı config blob'u
+static uint8_t acfg_blob[ACTIVITY_BLOB_MAX];
+static uint16_t acfg_len = 0;
+
+// MSEL ile seçilen kanal - profil (PRAMP..PSTOP) ve MSET komutları bu kanala gider
+static MotorChannel_t* selected_motor = MOTOR_MAIN;
+
+// MCPT ile gelen özel motor eğrisi noktaları
+static MotorCurve_Point_t mcpt_points[MOTOR_CURVE_MAX_POINTS];
+static uint8_t mcpt_count = 0;
+
+/**
+ * @brief USART2 alımını dairesel DMA ile başlatır (rxBuffer)
+ *        HT/TC ve IDLE olaylarında HAL_UARTEx_RxEventCallback çağrılır - byte başına kesme yok
+ */
+static void Command_StartRx(void)
+{
+    rx_pos = 0;
+    rx_len = 0;
+    rx_overflow = 0;
+    HAL_UARTEx_ReceiveToIdle_DMA(&huart2, rxBuffer, RX_BUFFER_SIZE);
+}
+
+void Command_Init(void)
+{
+    cmd_head = 0;
+    cmd_tail = 0;
+    Command_StartRx();
+}
+
+/**
+ * @brief DMA'dan gelen byte'ları satıra ekler, satır tamamlanınca kuyruğa koyar
+ */
+static void Command_Feed(const uint8_t* data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        char c = (char)data[i];
+
+        if (c == '\r' || c == '\n')
+        {
+            if (rx_overflow)
+            {
+                // Kırpılmış satır çalıştırılmaz: eksik argüman başka bir komut olurdu
+                command_too_long++;
+                rx_overflow = 0;
+                rx_len = 0;
+                continue;
+            }
+            if (rx_len == 0) continue;
+
+            if ((uint8_t)(cmd_head - cmd_tail) < CMD_QUEUE_DEPTH)
+            {
+                uint8_t slot = cmd_head % CMD_QUEUE_DEPTH;
+                memcpy(cmd_queue[slot], rx_line, rx_len);
+                cmd_queue[slot][rx_len] = '\0';
+                cmd_stamp[slot] = Timebase_Cycles();
+                cmd_head++;
+            }
+            else
+            {
+                command_dropped++;  // Kuyruk dolu - ana döngü geride kaldı
+            }
+            rx_len = 0;
+        }
+        else if (rx_len < CMD_LINE_SIZE - 1)
+        {
+            rx_line[rx_len++] = c;
+        }
+        else
+        {
+            rx_overflow = 1;
+        }
+    }
+}
+
+/**
+ * @brief Yarım/tam transfer veya hat boşta - pos: DMA'nın rxBuffer'da ulaştığı konum
+ *        Komut satırı IDLE ile son byte'tan bir karakter süresi sonra kuyruğa girer
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t pos)
+{
+    if (huart->Instance != USART2) return;
+
+    rx_events++;
+    if (pos != rx_pos)
+    {
+        if (pos > rx_pos)
+        {
+            Command_Feed(&rxBuffer[rx_pos], pos - rx_pos);
+        }
+        else
+        {
+            // Halka sardı
+            Command_Feed(&rxBuffer[rx_pos], RX_BUFFER_SIZE - rx_pos);
+            Command_Feed(rxBuffer, pos);
+        }
+        rx_pos = pos;
+    }
+    if (rx_pos == RX_BUFFER_SIZE) rx_pos = 0;
+}
+
+/**
+ * @brief Overrun vb. hatada HAL alım DMA'sını durdurur - yeniden başlat
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance != USART2) return;
+
+    rx_errors++;
+    if (huart->RxState == HAL_UART_STATE_READY) Command_StartRx();
+    UartTx_Resume();  // DMA hatasında gönderim zinciri durmuş olabilir
+}
+
+/**
+ * @brief Ana döngüden çağrılır - kuyruktaki tüm komutları sırayla işler
+ */
+void Command_Poll(void)
+{
+    while (cmd_tail != cmd_head)
+    {
+        uint8_t slot = cmd_tail % CMD_QUEUE_DEPTH;
+        uint32_t latency = Timebase_Cycles() - cmd_stamp[slot];
+
+        memcpy(cmd_line, cmd_queue[slot], CMD_LINE_SIZE);
+        cmd_tail++;
+
+        if (latency > latency_max_cycles) latency_max_cycles = latency;
+        command_count++;
+        ProcessCommand();
+    }
+}
+
+/**
+ * @brief Alım istatistikleri - satır sonundan işlenmeye kadar en uzun gecikme
+ */
+static void Command_Report(void)
+{
+    sprintf(debugMsg, "Rx[Komut:%lu Olay:%lu Atılan:%lu Uzun:%lu Hata:%lu Bekleyen:%u En uzun:%luus]\r\n",
+            command_count, rx_events, command_dropped, command_too_long, rx_errors,
+            (uint8_t)(cmd_head - cmd_tail), Timebase_CyclesToUs(latency_max_cycles));
+    SendDebugMessage(debugMsg);
+}
+
+/**
+ * @brief Hex dizisini (boşluksuz, "0A1B..") blob'a ekler
+ * @retval Eklenen byte sayısı, hata durumunda -1
+ */
+static int Command_AppendHex(const char* hex, uint8_t* dst, uint16_t* len, uint16_t max)
+{
+    int added = 0;
+
+    while (hex[0] != '\0' && hex[1] != '\0')
+    {
+        char byte_str[3] = {hex[0], hex[1], '\0'};
+        char* end;
+        long value = strtol(byte_str, &end, 16);
+        if (*end != '\0' || *len >= max) return -1;
+        dst[(*len)++] = (uint8_t)value;
+        hex += 2;
+        added++;
+    }
+    return (hex[0] == '\0') ? added : -1;
+}
+
+void ProcessCommand(void)
+{
+    char* cmd = cmd_line;
+
+    // "DF x" - hassas duty (0.01% adım, x<0 geri yön); "Dxx"'ten önce bakılmalı
+    if (strncmp(cmd, "DF ", 3) == 0)
+    {
+        long duty = strtol(&cmd[3], NULL, 10);
+        if (duty >= -MOTOR_DUTY_FULL && duty <= MOTOR_DUTY_FULL)
+        {
+            HW153_WriteDutyFine((int32_t)duty);
+            sprintf(debugMsg, "Duty: %ld/%d (Pulse: %ld)\r\n", duty, MOTOR_DUTY_FULL, HW153_GetPulse());
+            SendDebugMessage(debugMsg);
+        }
+    }
+    // "Dxx" formatında komut (xx = hız yüzdesi)
+    else if (cmd[0] == 'D')
+    {
+        int speed = atoi(&cmd[1]);
+        if (speed >= 0 && speed <= 100)
+        {
+            SetPWMDuty(speed);
+            sprintf(debugMsg, "Motor speed set to %d%%\r\n", speed);
+            SendDebugMessage(debugMsg);
+        }
+    }
+    else if (strcmp(cmd, "ARST") == 0)
+    {
+        Angle_Reset();
+        SendDebugMessage("Angle: reset\r\n");
+    }
+    else if (strcmp(cmd, "BRST") == 0)
+    {
+        GyroBias_Init(gyro_bias.accel_ok);
+        SendDebugMessage("Bias: reset\r\n");
+    }
+    else if (strncmp(cmd, "EVT ", 4) == 0)
+    {
+        MotionEvent_SetMotorEnabled(atoi(&cmd[4]) != 0);
+        sprintf(debugMsg, "Event motor actions: %s\r\n", atoi(&cmd[4]) ? "ON" : "OFF");
+        SendDebugMessage(debugMsg);
+    }
+    else if (strncmp(cmd, "STATW ", 6) == 0)
+    {
+        // "STATW i ms" - i. pencerenin uzunluğu
+        char* end;
+        long index = strtol(&cmd[6], &end, 10);
+        long length_ms = strtol(end, NULL, 10);
+        if (index >= 0 && index < MOTION_STATS_WINDOWS && length_ms > 0)
+        {
+            MotionStats_SetWindow((uint8_t)index, (uint32_t)length_ms);
+            sprintf(debugMsg, "Stats window %ld: %ldms\r\n", index, length_ms);
+            SendDebugMessage(debugMsg);
+        }
+    }
+    else if (strncmp(cmd, "FFTAX ", 6) == 0)
+    {
+        // "FFTAX n" - 0=X, 1=Y, 2=Z
+        int axis = atoi(&cmd[6]);
+        if (axis >= SPECTRUM_AXIS_X && axis <= SPECTRUM_AXIS_Z)
+        {
+            Spectrum_SetAxis((Spectrum_Axis_t)axis);
+            sprintf(debugMsg, "Spectrum axis: %c\r\n", 'X' + axis);
+            SendDebugMessage(debugMsg);
+        }
+    }
+    else if (strncmp(cmd, "ACFG ", 5) == 0)
+    {
+        // "ACFG BEGIN" / "ACFG <hex>" / "ACFG END" - satır boyu kısa, blob parça parça gelir
+        if (strcmp(&cmd[5], "BEGIN") == 0)
+        {
+            acfg_len = 0;
+            SendDebugMessage("Activity config: begin\r\n");
+        }
+        else if (strcmp(&cmd[5], "END") == 0)
+        {
+            HAL_StatusTypeDef status = Activity_LoadConfig(acfg_blob, acfg_len);
+            sprintf(debugMsg, "Activity config: %s (%u bytes)\r\n",
+                    status == HAL_OK ? "loaded" : "rejected", acfg_len);
+            SendDebugMessage(debugMsg);
+            acfg_len = 0;
+        }
+        else if (Command_AppendHex(&cmd[5], acfg_blob, &acfg_len, sizeof(acfg_blob)) < 0)
+        {
+            acfg_len = 0;
+            SendDebugMessage("Activity config: bad hex, restart with ACFG BEGIN\r\n");
+        }
+    }
+    else if (strcmp(cmd, "ACT") == 0)
+    {
+        Activity_ReportFeatures();
+    }
+    else if (strncmp(cmd, "PID ", 4) == 0)
+    {
+        Pid_Enable(atoi(&cmd[4]) != 0);
+        sprintf(debugMsg, "PID: %s\r\n", atoi(&cmd[4]) ? "ON" : "OFF");
+        SendDebugMessage(debugMsg);
+    }
+    else if (strncmp(cmd, "PIDG ", 5) == 0)
+    {
+        // "PIDG kp ki kd"
+        char* end;
+        float kp = strtof(&cmd[5], &end);
+        float ki = strtof(end, &end);
+        float kd = strtof(end, NULL);
+        Pid_SetGains(kp, ki, kd);
+        Pid_Report();
+    }
+    else if (strncmp(cmd, "PIDSP ", 6) == 0)
+    {
+        Pid_SetSetpoint(strtof(&cmd[6], NULL));
+        Pid_Report();
+    }
+    else if (strncmp(cmd, "PIDFB ", 6) == 0)
+    {
+        // "PIDFB src axis" - 0=gyro hızı, 1=açı, 2=harici, 3=encoder rpm; eksen 0..2
+        char* end;
+        long source = strtol(&cmd[6], &end, 10);
+        long axis = strtol(end, NULL, 10);
+        if (source >= 0 && source < PID_FB_COUNT && axis >= 0 && axis <= 2)
+        {
+            Pid_SetFeedback((Pid_Feedback_t)source, (uint8_t)axis);
+            Pid_Report();
+        }
+    }
+    else if (strncmp(cmd, "PIDDF ", 6) == 0)
+    {
+        float hz = strtof(&cmd[6], NULL);
+        if (hz > 0.0f && hz < (float)CONTROL_TICK_HZ / 2.0f)
+        {
+            Pid_SetDerivativeCutoff(hz);
+            sprintf(debugMsg, "PID D filter: %.1fHz\r\n", hz);
+            SendDebugMessage(debugMsg);
+        }
+    }
+    else if (strncmp(cmd, "PIDEXT ", 7) == 0)
+    {
+        Pid_SetExternal(strtof(&cmd[7], NULL));
+    }
+    else if (strcmp(cmd, "PIDST") == 0)
+    {
+        Pid_Report();
+        Control_Report();
+    }
+    else if (strcmp(cmd, "PIDSAVE") == 0 || strcmp(cmd, "PIDLOAD") == 0)
+    {
+        HAL_StatusTypeDef status = (cmd[3] == 'S') ? Pid_SaveGains() : Pid_LoadGains();
+        sprintf(debugMsg, "PID flash: %s\r\n", status == HAL_OK ? "OK" : status == HAL_BUSY ? "rejected (motor aktif)" :
+                                                  (cmd[3] == 'S') ? "yazma hatası" : "kayıt yok");
+        SendDebugMessage(debugMsg);
+        Pid_Report();
+    }
+    else if (strncmp(cmd, "TUNE ", 5) == 0)
+    {
+        // "TUNE d bias eps rule [s]" - röle ±d% bias% etrafında, histerezis eps, zaman aşımı s
+        char* p = &cmd[5];
+        float relay = strtof(p, &p);
+        float bias = strtof(p, &p);
+        float eps = strtof(p, &p);
+        long rule = strtol(p, &p, 10);
+        unsigned long timeout_s = strtoul(p, NULL, 10);
+        if (timeout_s == 0) timeout_s = 20;
+        HAL_StatusTypeDef status = HAL_ERROR;
+        if (rule >= 0 && timeout_s <= 60)
+        {
+            status = PidTune_Start(relay, bias, eps, (PidTune_Rule_t)rule, (uint16_t)(timeout_s * 1000));
+        }
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "Tune: %s\r\n", status == HAL_BUSY ? "rejected (hata/deneme aktif)" : "invalid");
+            SendDebugMessage(debugMsg);
+        }
+        PidTune_Report();
+    }
+    else if (strcmp(cmd, "TUNESTOP") == 0)
+    {
+        PidTune_Stop();
+    }
+    else if (strcmp(cmd, "TUNEST") == 0)
+    {
+        PidTune_Report();
+    }
+    else if (strncmp(cmd, "PFF ", 4) == 0)
+    {
+        // "PFF g h [fc]" - öncü kazancı (0 = kapalı), ek ufuk ms, türev filtresi Hz
+        char* p = &cmd[4];
+        float gain = strtof(p, &p);
+        float horizon = strtof(p, &p);
+        float fc = strtof(p, NULL);
+        if (fc == 0.0f) fc = rate_predict_config.d_cutoff_hz;
+        if (RatePredict_Configure(gain, horizon, fc) != HAL_OK)
+        {
+            SendDebugMessage("PFF: invalid (g 0..2, h 0..50 ms)\r\n");
+        }
+        RatePredict_Report();
+    }
+    else if (strncmp(cmd, "LAT ", 4) == 0)
+    {
+        // "LAT ms [eksen]" - ms boyunca örnek -> PWM gecikmesi ve tahmin öncüsü
+        char* p = &cmd[4];
+        unsigned long ms = strtoul(p, &p, 10);
+        char* end;
+        long axis = strtol(p, &end, 10);
+        if (end == p) axis = pid_config.axis;
+        HAL_StatusTypeDef status = (ms > 0xFFFF || axis < 0) ? HAL_ERROR : RatePredict_Measure((uint16_t)ms, (uint8_t)axis);
+        sprintf(debugMsg, "Lat: %s\r\n", status == HAL_OK ? "olculuyor - ekseni hareket ettirin" :
+                                            status == HAL_BUSY ? "busy" : "invalid");
+        SendDebugMessage(debugMsg);
+    }
+    else if (strcmp(cmd, "LATST") == 0)
+    {
+        RatePredict_Report();
+    }
+    else if (strncmp(cmd, "SYNC ", 5) == 0)
+    {
+        // "SYNC m [faz%]" - 0=asenkron, 1=iletim ortası (CC4), 2=periyodun faz% noktası
+        char* p = &cmd[5];
+        long mode = strtol(p, &p, 10);
+        unsigned long phase = strtoul(p, NULL, 10);
+        if (mode < 0 || phase > 99 || SampleSync_Configure((SampleSync_Mode_t)mode, (uint8_t)phase) != HAL_OK)
+        {
+            SendDebugMessage("Sync: invalid (m 0..2, p 0..99; 1/2 için PWM periyodu <= 100us)\r\n");
+        }
+        SampleSync_Report();
+    }
+    else if (strcmp(cmd, "SYNCST") == 0)
+    {
+        SampleSync_Report();
+    }
+    else if (strncmp(cmd, "NOISE ", 6) == 0)
+    {
+        // "NOISE ms" - kart hareketsiz, motor dönerken senkron/asenkron RMS gürültü
+        unsigned long ms = strtoul(&cmd[6], NULL, 10);
+        HAL_StatusTypeDef status = (ms > 0xFFFF) ? HAL_ERROR : SampleSync_NoiseStart((uint16_t)ms);
+        sprintf(debugMsg, "Noise: %s\r\n", status == HAL_OK ? "ölçülüyor - kartı oynatmayın" :
+                                              status == HAL_BUSY ? "busy" : "invalid (PWM periyodu <= 100us olmalı)");
+        SendDebugMessage(debugMsg);
+    }
+    else if (strcmp(cmd, "TXST") == 0)
+    {
+        UartTx_Report();
+    }
+    else if (strcmp(cmd, "RXST") == 0)
+    {
+        Command_Report();
+    }
+    else if (strncmp(cmd, "PRAMP ", 6) == 0 || strncmp(cmd, "PHOLD ", 6) == 0 ||
+             strncmp(cmd, "PPULSE ", 7) == 0 || strncmp(cmd, "PBRAKE ", 7) == 0)
+    {
+        // "PRAMP d ms" / "PHOLD d ms" / "PPULSE d on off n" / "PBRAKE p ms" - d: -100..100 (işaret = yön)
+        MotorSegment_t seg = {0};
+        char* end;
+        long v[4] = {0};
+        char* p = strchr(cmd, ' ');
+        for (int i = 0; i < 4; i++)
+        {
+            v[i] = strtol(p, &end, 10);
+            p = end;
+        }
+        seg.type = (cmd[1] == 'R') ? MOTOR_SEG_RAMP : (cmd[1] == 'H') ? MOTOR_SEG_HOLD :
+                   (cmd[1] == 'B') ? MOTOR_SEG_BRAKE : MOTOR_SEG_PULSE;
+        seg.duty = (int8_t)((v[0] > 100) ? 100 : (v[0] < -100) ? -100 : v[0]);
+        seg.time_ms = (uint16_t)v[1];
+        seg.off_ms = (uint16_t)v[2];
+        seg.count = (uint8_t)v[3];
+
+        HAL_StatusTypeDef status = MotorProfile_Start(selected_motor, &seg, 1);
+        sprintf(debugMsg, "Profile %s: %s\r\n", selected_motor->name, status == HAL_OK ? "started" : "rejected (PID aktif)");
+        SendDebugMessage(debugMsg);
+    }
+    else if (strncmp(cmd, "PMOVE ", 6) == 0)
+    {
+        // "PMOVE peak cruise_ms end accel jerk" - S-curve (jerk=0: trapez)
+        MotorSegment_t seg = {0};
+        char* p = &cmd[6];
+        long v[5];
+        for (int i = 0; i < 5; i++)
+        {
+            v[i] = strtol(p, &p, 10);
+        }
+        seg.type = MOTOR_SEG_MOVE;
+        seg.duty = (int8_t)((v[0] > 100) ? 100 : (v[0] < -100) ? -100 : v[0]);
+        seg.time_ms = (uint16_t)v[1];
+        seg.end_duty = (int8_t)((v[2] > 100) ? 100 : (v[2] < -100) ? -100 : v[2]);
+        seg.accel = (uint16_t)v[3];
+        seg.jerk = (uint16_t)v[4];
+
+        if (MotorProfile_Start(selected_motor, &seg, 1) == HAL_OK)
+        {
+            sprintf(debugMsg, "Move %s: started, T:%lums\r\n", selected_motor->name, MotorProfile_ExpectedMs(selected_motor));
+        }
+        else
+        {
+            sprintf(debugMsg, "Move: rejected\r\n");
+        }
+        SendDebugMessage(debugMsg);
+    }
+    else if (strcmp(cmd, "PSTOP") == 0)
+    {
+        MotorProfile_Cancel(selected_motor);
+        MotorProfile_Report(selected_motor);
+    }
+    else if (strncmp(cmd, "MQ ", 3) == 0)
+    {
+        // "MQ dt_us duty dir" - kuyruktaki son komuttan (boşsa şimdiden) dt_us sonra
+        char* p = &cmd[3];
+        unsigned long dt_us = strtoul(p, &p, 10);
+        long duty = strtol(p, &p, 10);
+        long dir = strtol(p, NULL, 10);
+        if (duty >= 0 && duty <= 100)
+        {
+            uint32_t at = MotorQueue_LastTime() + (uint32_t)dt_us;
+            HAL_StatusTypeDef status = MotorQueue_Push(at, (uint8_t)duty,
+                                                       dir ? MOTOR_DIRECTION_BACKWARD : MOTOR_DIRECTION_FORWARD);
+            if (status != HAL_OK)
+            {
+                sprintf(debugMsg, "MQ: %s\r\n", status == HAL_BUSY ? "rejected (PID aktif)" : "full");
+                SendDebugMessage(debugMsg);
+            }
+        }
+    }
+    else if (strcmp(cmd, "MQFL") == 0)
+    {
+        MotorQueue_Flush();
+        SendDebugMessage("MQ: flushed\r\n");
+    }
+    else if (strcmp(cmd, "MQST") == 0)
+    {
+        MotorQueue_Report();
+    }
+    else if (strcmp(cmd, "PST") == 0)
+    {
+        for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++) MotorProfile_Report(&motor_channels[i]);
+    }
+    else if (strncmp(cmd, "MSEL ", 5) == 0)
+    {
+        // "MSEL n" - profil ve MSET hedef kanalı (0 = ana motor)
+        MotorChannel_t* ch = MotorChannel_Get((uint8_t)strtoul(&cmd[5], NULL, 10));
+        if (ch != NULL) selected_motor = ch;
+        sprintf(debugMsg, "Motor: %s secili\r\n", selected_motor->name);
+        SendDebugMessage(debugMsg);
+    }
+    else if (strncmp(cmd, "MSET ", 5) == 0)
+    {
+        // "MSET d" - seçili kanalda d% (-100..100), çalışan profil kesilir
+        long duty = strtol(&cmd[5], NULL, 10);
+        if (duty >= -100 && duty <= 100)
+        {
+            if (MotorProfile_IsActive(selected_motor)) MotorProfile_Cancel(selected_motor);
+            MotorChannel_WriteDutyFine(selected_motor, (int32_t)duty * (MOTOR_DUTY_FULL / 100));
+        }
+        MotorChannel_Report();
+    }
+    else if (strncmp(cmd, "MLIM ", 5) == 0)
+    {
+        // "MLIM n max inv" - kanal n: en fazla max% duty, inv=1 yön ters
+        char* p = &cmd[5];
+        unsigned long index = strtoul(p, &p, 10);
+        unsigned long max = strtoul(p, &p, 10);
+        unsigned long inv = strtoul(p, NULL, 10);
+        MotorChannel_t* ch = MotorChannel_Get((uint8_t)index);
+        if (ch == NULL || max > 100 || MotorChannel_SetLimits(ch, (uint16_t)(max * (MOTOR_DUTY_FULL / 100)), (uint8_t)inv) != HAL_OK)
+        {
+            SendDebugMessage("Motor: invalid (n 0..3, max 1..100)\r\n");
+        }
+        MotorChannel_Report();
+    }
+    else if (strcmp(cmd, "MCH") == 0)
+    {
+        MotorChannel_Report();
+    }
+    else if (strncmp(cmd, "PWM ", 4) == 0)
+    {
+        // "PWM hz [adım]" - adım verilmezse en yüksek çözünürlük
+        char* p = &cmd[4];
+        unsigned long hz = strtoul(p, &p, 10);
+        unsigned long steps = strtoul(p, NULL, 10);
+        HAL_StatusTypeDef status = Motor_ConfigurePwm((uint32_t)hz, (uint32_t)steps);
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "PWM: %s\r\n", status == HAL_BUSY ? "rejected (profil aktif)" : "invalid");
+            SendDebugMessage(debugMsg);
+        }
+        Motor_PwmReport();
+    }
+    else if (strcmp(cmd, "PWMST") == 0)
+    {
+        Motor_PwmReport();
+    }
+    else if (strncmp(cmd, "WGEN ", 5) == 0)
+    {
+        // "WGEN şekil genlik% periyot_ms" - tek periyot yükler, WPLAY ile çalınır
+        char* p = &cmd[5];
+        long shape = strtol(p, &p, 10);
+        long amp = strtol(p, &p, 10);
+        unsigned long ms = strtoul(p, NULL, 10);
+        HAL_StatusTypeDef status = HAL_ERROR;
+        if (shape >= 0 && amp > 0 && amp <= 100)
+        {
+            status = MotorWave_Generate((MotorWave_Shape_t)shape, amp * (MOTOR_DUTY_FULL / 100), (uint32_t)ms);
+        }
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "Wave: %s\r\n", status == HAL_BUSY ? "busy" : "invalid (tampon: PWM periyodu başına 1 örnek)");
+            SendDebugMessage(debugMsg);
+        }
+        MotorWave_Report();
+    }
+    else if (strncmp(cmd, "WPLAY ", 6) == 0)
+    {
+        HAL_StatusTypeDef status = MotorWave_Play((uint16_t)strtoul(&cmd[6], NULL, 10));
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "Wave: %s\r\n", status == HAL_BUSY ? "rejected (PID aktif)" : "dalga yok / PWM değişti");
+            SendDebugMessage(debugMsg);
+        }
+    }
+    else if (strncmp(cmd, "WQ ", 3) == 0)
+    {
+        // "WQ duty% on_ms off_ms n" - akış kuyruğuna ekler, akış durmuşsa başlatır
+        char* p = &cmd[3];
+        long duty = strtol(p, &p, 10);
+        unsigned long on_ms = strtoul(p, &p, 10);
+        unsigned long off_ms = strtoul(p, &p, 10);
+        unsigned long count = strtoul(p, NULL, 10);
+        if (count == 0) count = 1;
+        HAL_StatusTypeDef status = HAL_ERROR;
+        if (duty >= -100 && duty <= 100 && count <= 0xFFFF)
+        {
+            status = MotorWave_Queue(duty * (MOTOR_DUTY_FULL / 100), (uint32_t)on_ms, (uint32_t)off_ms, (uint16_t)count);
+            if (status == HAL_OK) status = MotorWave_Stream();
+        }
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "Wave: %s\r\n", status == HAL_BUSY ? "rejected (PID aktif)" : "full/invalid");
+            SendDebugMessage(debugMsg);
+        }
+    }
+    else if (strcmp(cmd, "WSTOP") == 0)
+    {
+        MotorWave_Stop();
+        MotorWave_Report();
+    }
+    else if (strcmp(cmd, "WST") == 0)
+    {
+        MotorWave_Report();
+    }
+    else if (strncmp(cmd, "MCURVE ", 7) == 0)
+    {
+        // "MCURVE t min max k" (0=doğrusal, 1=üstel, 2=S) veya "MCURVE DEF"
+        HAL_StatusTypeDef status;
+        if (strcmp(&cmd[7], "DEF") == 0)
+        {
+            status = MotorCurve_Build(MOTOR_CURVE_DEFAULT, 0.0f, 0.0f, 0.0f);
+        }
+        else
+        {
+            char* end;
+            long type = strtol(&cmd[7], &end, 10);
+            float min_dps = strtof(end, &end);
+            float max_dps = strtof(end, &end);
+            float k = strtof(end, NULL);
+            status = (type >= 0 && type <= MOTOR_CURVE_SCURVE)
+                   ? MotorCurve_Build((MotorCurve_Type_t)type, min_dps, max_dps, k) : HAL_ERROR;
+        }
+        if (status != HAL_OK) SendDebugMessage("Curve: invalid\r\n");
+        MotorCurve_Report();
+    }
+    else if (strncmp(cmd, "MCPT ", 5) == 0)
+    {
+        // "MCPT BEGIN" / "MCPT dps duty%" / "MCPT END" - noktalar artan dps sırasında
+        if (strcmp(&cmd[5], "BEGIN") == 0)
+        {
+            mcpt_count = 0;
+        }
+        else if (strcmp(&cmd[5], "END") == 0)
+        {
+            if (MotorCurve_BuildCustom(mcpt_points, mcpt_count) != HAL_OK)
+            {
+                SendDebugMessage("Curve: custom rejected\r\n");
+            }
+            MotorCurve_Report();
+            mcpt_count = 0;
+        }
+        else if (mcpt_count < MOTOR_CURVE_MAX_POINTS)
+        {
+            char* end;
+            float dps = strtof(&cmd[5], &end);
+            float duty = strtof(end, NULL);
+            if (duty < 0.0f) duty = 0.0f;
+            else if (duty > 100.0f) duty = 100.0f;
+            mcpt_points[mcpt_count].dps = dps;
+            mcpt_points[mcpt_count].duty = (uint16_t)(duty * (MOTOR_DUTY_FULL / 100) + 0.5f);
+            mcpt_count++;
+        }
+        else
+        {
+            SendDebugMessage("Curve: too many points\r\n");
+        }
+    }
+    else if (strcmp(cmd, "MCST") == 0)
+    {
+        MotorCurve_Report();
+    }
+    else if (strncmp(cmd, "MOUT ", 5) == 0)
+    {
+        // "MOUT on off band slew" - hassas duty birimi (10000 = %100)
+        char* p = &cmd[5];
+        unsigned long on = strtoul(p, &p, 10);
+        unsigned long off = strtoul(p, &p, 10);
+        unsigned long band = strtoul(p, &p, 10);
+        unsigned long slew = strtoul(p, NULL, 10);
+        if (on <= MOTOR_DUTY_FULL && off <= on && band <= MOTOR_DUTY_FULL && slew <= MOTOR_DUTY_FULL)
+        {
+            motor_output_config.deadband_on = (uint16_t)on;
+            motor_output_config.deadband_off = (uint16_t)off;
+            motor_output_config.hysteresis = (uint16_t)band;
+            motor_output_config.slew_per_tick = (uint16_t)slew;
+        }
+        else
+        {
+            SendDebugMessage("Out: invalid (off <= on <= 10000)\r\n");
+        }
+        MotorOutput_Report();
+    }
+    else if (strcmp(cmd, "MOST") == 0)
+    {
+        MotorOutput_Report();
+    }
+    else if (strncmp(cmd, "ENC ", 4) == 0)
+    {
+        // "ENC mode cpr window stall" - 0=quadrature, 1=tako; pencere/takılma ms
+        char* p = &cmd[4];
+        unsigned long mode = strtoul(p, &p, 10);
+        unsigned long cpr = strtoul(p, &p, 10);
+        unsigned long window = strtoul(p, &p, 10);
+        unsigned long stall = strtoul(p, NULL, 10);
+        if (cpr > 0xFFFF || stall > 0xFFFF ||
+            Encoder_Configure((Encoder_Mode_t)mode, (uint16_t)cpr, (uint16_t)window, (uint16_t)stall) != HAL_OK)
+        {
+            sprintf(debugMsg, "Enc: invalid (mode 0/1, cpr>0, 1<=win<%d, stall>win)\r\n", ENCODER_HISTORY);
+            SendDebugMessage(debugMsg);
+        }
+        Encoder_Report();
+    }
+    else if (strcmp(cmd, "ENCST") == 0)
+    {
+        Encoder_Report();
+    }
+    else if (strncmp(cmd, "ILIM ", 5) == 0)
+    {
+        // "ILIM peak avg ms mv/A" - tepe (watchdog) ve ortalama sınır mA
+        char* p = &cmd[5];
+        unsigned long peak = strtoul(p, &p, 10);
+        unsigned long avg = strtoul(p, &p, 10);
+        unsigned long ms = strtoul(p, &p, 10);
+        unsigned long gain = strtoul(p, NULL, 10);
+        if (peak > 0xFFFF || ms > 0xFFFF || gain > 0xFFFF ||
+            CurrentSense_Configure((uint16_t)peak, (uint16_t)avg, (uint16_t)ms, (uint16_t)gain) != HAL_OK)
+        {
+            SendDebugMessage("Cur: invalid (avg <= peak, ms > 0, mV/A > 0)\r\n");
+        }
+        CurrentSense_Report();
+    }
+    else if (strcmp(cmd, "ICAL") == 0)
+    {
+        if (CurrentSense_Calibrate() != HAL_OK) SendDebugMessage("Cur: motor durmali\r\n");
+        CurrentSense_Report();
+    }
+    else if (strcmp(cmd, "ICLR") == 0)
+    {
+        CurrentSense_ClearFault();
+        CurrentSense_Report();
+    }
+    else if (strcmp(cmd, "IST") == 0)
+    {
+        CurrentSense_Report();
+    }
+    else if (strncmp(cmd, "BRK ", 4) == 0 || strcmp(cmd, "COAST") == 0)
+    {
+        // "BRK ms pct" - pct% fren ms boyunca, sonra serbest; "COAST" - serbest durma
+        HAL_StatusTypeDef status;
+        if (cmd[0] == 'B')
+        {
+            char* p = &cmd[4];
+            unsigned long ms = strtoul(p, &p, 10);
+            unsigned long pct = strtoul(p, NULL, 10);
+            if (pct == 0) pct = 100;
+            status = (ms > 0xFFFF || pct > 100) ? HAL_ERROR :
+                     MotorStop_Begin(MOTOR_STOP_BRAKE, (uint16_t)ms, (uint8_t)pct);
+        }
+        else
+        {
+            status = MotorStop_Begin(MOTOR_STOP_COAST, 0, 0);
+        }
+        sprintf(debugMsg, "Stop: %s\r\n", status == HAL_OK ? (MotorStop_IsMeasuring() ? "olculuyor" : "motor zaten duruyor") :
+                                             status == HAL_BUSY ? "rejected (PID aktif)" : "invalid (BRK ms 1..100)");
+        SendDebugMessage(debugMsg);
+    }
+    else if (strncmp(cmd, "STOPM ", 6) == 0)
+    {
+        // "STOPM m" - 0=serbest, 1=fren; HW153_SetMotor(0) ve Motor_Stop için
+        long mode = strtol(&cmd[6], NULL, 10);
+        if (mode == 0 || mode == 1) Motor_SetStopMode((Motor_StopMode_t)mode);
+        MotorStop_Report();
+    }
+    else if (strcmp(cmd, "STOPST") == 0)
+    {
+        MotorStop_Report();
+    }
+    else if (strncmp(cmd, "ID ", 3) == 0)
+    {
+        // "ID s off% amp% pre_ms ms [a b]" - 0=basamak, 1=PRBS (a = bit ms), 2=chirp (a..b Hz)
+        char* p = &cmd[3];
+        long signal = strtol(p, &p, 10);
+        float offset = strtof(p, &p);
+        float amp = strtof(p, &p);
+        unsigned long pre_ms = strtoul(p, &p, 10);
+        unsigned long ms = strtoul(p, &p, 10);
+        float a = strtof(p, &p);
+        float b = strtof(p, NULL);
+        HAL_StatusTypeDef status = HAL_ERROR;
+        if (signal >= 0 && fabsf(offset) <= 100.0f && fabsf(amp) <= 100.0f && pre_ms <= 0xFFFF && ms <= 0xFFFF)
+        {
+            status = MotorIdent_Start((MotorIdent_Signal_t)signal,
+                                      (int16_t)lroundf(offset * (MOTOR_DUTY_FULL / 100)),
+                                      (int16_t)lroundf(amp * (MOTOR_DUTY_FULL / 100)),
+                                      (uint16_t)pre_ms, (uint16_t)ms, a, b);
+        }
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "Ident: %s\r\n", status == HAL_BUSY ? "rejected (PID/hata/kayıt aktif)" :
+                                                 "invalid (tampon 2048 örnek, chirp <= Nyquist)");
+            SendDebugMessage(debugMsg);
+        }
+        MotorIdent_Report();
+    }
+    else if (strncmp(cmd, "IDSRC ", 6) == 0)
+    {
+        // "IDSRC s a dec" - yanıt kaynağı (PIDFB numaraları), eksen, dec tick'te bir örnek
+        char* p = &cmd[6];
+        long source = strtol(p, &p, 10);
+        long axis = strtol(p, &p, 10);
+        unsigned long decim = strtoul(p, NULL, 10);
+        if (decim == 0) decim = 1;
+        HAL_StatusTypeDef status = HAL_ERROR;
+        if (source >= 0 && axis >= 0 && decim <= 0xFFFF)
+        {
+            status = MotorIdent_SetSource((Pid_Feedback_t)source, (uint8_t)axis, (uint16_t)decim);
+        }
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "Ident: %s\r\n", status == HAL_BUSY ? "busy" : "invalid");
+            SendDebugMessage(debugMsg);
+        }
+        MotorIdent_Report();
+    }
+    else if (strcmp(cmd, "IDDUMP") == 0)
+    {
+        HAL_StatusTypeDef status = MotorIdent_Dump();
+        if (status != HAL_OK)
+        {
+            sprintf(debugMsg, "Ident: %s\r\n", status == HAL_BUSY ? "kayıt sürüyor" : "kayıt yok");
+            SendDebugMessage(debugMsg);
+        }
+    }
+    else if (strcmp(cmd, "IDSTOP") == 0)
+    {
+        MotorIdent_Stop();
+        MotorIdent_Report();
+    }
+    else if (strcmp(cmd, "IDST") == 0)
+    {
+        MotorIdent_Report();
+    }
+    else
+    {
+        sprintf(debugMsg, "Bilinmeyen komut: %s\r\n", cmd);
+        SendDebugMessage(debugMsg);
+    }
+}
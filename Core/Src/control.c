@@ -0,0 +1,109 @@
+#include "control.h"
+#include "tim.h"
+#include "timebase.h"
+#include "pid.h"
+#include "encoder.h"
+#include "current_sense.h"
+#include "motor_stop.h"
+#include "motor_ident.h"
+#include "pid_tune.h"
+#include "motor_profile.h"
+#include <stdio.h>
+
+volatile Control_Stats_t control_stats;
+
+static uint32_t last_entry = 0;
+static uint32_t period_cycles = 0;
+
+static float Control_CyclesToUs(int32_t cycles)
+{
+    return (float)cycles * 1e6f / (float)SystemCoreClock;
+}
+
+static void Control_ResetStats(void)
+{
+    control_stats.exec_cycles_max = 0;
+    control_stats.exec_cycles_sum = 0;
+    control_stats.exec_count = 0;
+    control_stats.jitter_min = INT32_MAX;
+    control_stats.jitter_max = INT32_MIN;
+}
+
+/**
+ * @brief TIM6 update kesmesini başlatır
+ */
+void Control_Init(void)
+{
+    period_cycles = SystemCoreClock / CONTROL_TICK_HZ;
+    last_entry = 0;
+    control_stats.ticks = 0;
+    Control_ResetStats();
+
+    HAL_TIM_Base_Start_IT(&htim6);
+}
+
+/**
+ * @brief Kontrol tick'i - TIM6 kesmesinden çağrılır
+ */
+void Control_Tick(void)
+{
+    uint32_t entry = Timebase_Cycles();
+
+    if (last_entry != 0)
+    {
+        int32_t jitter = (int32_t)(entry - last_entry - period_cycles);
+        if (jitter < control_stats.jitter_min) control_stats.jitter_min = jitter;
+        if (jitter > control_stats.jitter_max) control_stats.jitter_max = jitter;
+    }
+    last_entry = entry;
+    control_stats.ticks++;
+
+    CurrentSense_Tick();
+    Encoder_Tick();     // PID RPM geri beslemesi bu tick'in hızını kullanır
+    MotorStop_Tick();
+    MotorIdent_Tick();
+    PidTune_Tick();
+    Pid_Tick();
+
+    uint32_t exec = Timebase_Cycles() - entry;
+    if (exec > control_stats.exec_cycles_max) control_stats.exec_cycles_max = exec;
+    control_stats.exec_cycles_sum += exec;
+    control_stats.exec_count++;
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM6)
+    {
+        Control_Tick();
+    }
+    else if (htim->Instance == TIM3)
+    {
+        MotorProfile_Tick();    // PWM periyodu başına bir profil adımı
+    }
+}
+
+/**
+ * @brief Çalışma süresi ve jitter - son rapordan beri
+ */
+void Control_Report(void)
+{
+    char msg[112];
+    Control_Stats_t s;
+
+    __disable_irq();
+    s = control_stats;
+    Control_ResetStats();
+    __enable_irq();
+
+    if (s.exec_count == 0) return;
+    if (s.jitter_min > s.jitter_max) s.jitter_min = s.jitter_max = 0;   // Tek tick
+
+    sprintf(msg, "Ctl[T:%lu Exec:%.2f/%.2fus Jit:%+.2f/%+.2fus]\r\n",
+            s.ticks,
+            Control_CyclesToUs((int32_t)(s.exec_cycles_sum / s.exec_count)),
+            Control_CyclesToUs((int32_t)s.exec_cycles_max),
+            Control_CyclesToUs(s.jitter_min),
+            Control_CyclesToUs(s.jitter_max));
+    SendDebugMessage(msg);
+}
@@ -0,0 +1,235 @@
+#include "current_sense.h"
+#include "adc.h"
+#include "control.h"
+#include "motor.h"
+#include "motor_profile.h"
+#include "motor_queue.h"
+#include "motor_wave.h"
+#include "motion_event.h"
+#include "pid.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+CurrentSense_Config_t current_sense_config;
+CurrentSense_Status_t current_sense_status;
+
+static volatile uint16_t samples[CURRENT_SENSE_SAMPLES];    // DMA hedefi
+static float ma_per_lsb = 0.0f;
+static float filter_alpha = 0.0f;
+static uint16_t over_ms = 0;
+static uint8_t fault_handled = 0;
+
+static const char* const trip_names[] = { "none", "PEAK", "AVG" };
+
+/**
+ * @brief Çıkışları anında keser - ISR'den çağrılır
+ * OCxM = force inactive CCMR yazılır yazılmaz geçerli; CCR preload'u update'i bekler.
+ */
+static void CurrentSense_Trip(CurrentSense_Trip_t reason)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();                    // TIM6 yolu watchdog tarafından kesilebilir
+
+    TIM3->CCMR1 = (TIM3->CCMR1 & ~(TIM_CCMR1_OC1M | TIM_CCMR1_OC2M)) |
+                  TIM_OCMODE_FORCED_INACTIVE | (TIM_OCMODE_FORCED_INACTIVE << 8);
+    TIM3->CCR1 = 0;
+    TIM3->CCR2 = 0;
+    ADC1->IER &= ~ADC_IER_AWD1IE;       // Akım sönene kadar her dönüşümde tekrar etmesin
+
+    if (current_sense_status.fault != CURRENT_TRIP_NONE)
+    {
+        __set_PRIMASK(primask);
+        return;
+    }
+    current_sense_status.fault = reason;
+    if (reason == CURRENT_TRIP_PEAK)
+    {
+        // Tetikten (CNT == CCR4) bu yana geçen timer sayımı
+        uint32_t period = TIM3->ARR + 1;
+        uint32_t ticks = (TIM3->CNT + period - TIM3->CCR4) % period;
+        current_sense_status.trip_latency_cycles = ticks * (TIM3->PSC + 1);
+        current_sense_status.peak_trips++;
+    }
+    else
+    {
+        current_sense_status.average_trips++;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Analog watchdog eşiğini yazar - TR1 sadece dönüşüm dururken yazılabilir
+ */
+static void CurrentSense_ApplyThreshold(void)
+{
+    uint32_t high = current_sense_status.offset +
+                    (uint32_t)((float)current_sense_config.peak_ma / ma_per_lsb);
+    if (high > CURRENT_SENSE_FULL) high = CURRENT_SENSE_FULL;
+
+    ADC1->CR |= ADC_CR_ADSTP;
+    while (ADC1->CR & ADC_CR_ADSTP)
+    {
+    }
+    ADC1->TR1 = (high << ADC_TR1_HT1_Pos);
+    ADC1->CR |= ADC_CR_ADSTART;
+}
+
+static float CurrentSense_BufferMean(void)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < CURRENT_SENSE_SAMPLES; i++) sum += samples[i];
+    return (float)sum / (float)CURRENT_SENSE_SAMPLES;
+}
+
+/**
+ * @brief Varsayılan: 1 V/A sense, 3 A tepe, 2 A ortalama / 5 ms
+ * ADC başlatılır, motor dururken sıfır noktası ölçülür.
+ */
+void CurrentSense_Init(void)
+{
+    current_sense_config.peak_ma = 3000;
+    current_sense_config.average_ma = 2000;
+    current_sense_config.sw_trip_ms = 5;
+    current_sense_config.mv_per_a = 1000;
+
+    memset(&current_sense_status, 0, sizeof(current_sense_status));
+    ma_per_lsb = CURRENT_SENSE_VREF_MV / (float)(CURRENT_SENSE_FULL + 1) * 1000.0f / (float)current_sense_config.mv_per_a;
+    filter_alpha = 1.0f - expf(-2.0f * 3.14159265f * CURRENT_SENSE_FILTER_HZ / (float)CONTROL_TICK_HZ);
+
+    MX_ADC1_Init((uint16_t*)samples, CURRENT_SENSE_SAMPLES);
+    HAL_Delay(5);   // Motor kapalıyken tampon dolsun
+    CurrentSense_Calibrate();
+}
+
+/**
+ * @brief Sıfır akım noktasını ölçer ve watchdog eşiğini günceller
+ * @retval HAL_BUSY: motor sürülüyor
+ */
+HAL_StatusTypeDef CurrentSense_Calibrate(void)
+{
+    if (HW153_GetPulse() != 0) return HAL_BUSY;
+
+    current_sense_status.offset = (uint16_t)(CurrentSense_BufferMean() + 0.5f);
+    CurrentSense_ApplyThreshold();
+    return HAL_OK;
+}
+
+/**
+ * @brief Sınırlar ve sense kazancı
+ * @retval HAL_ERROR: ortalama sınır tepe eşiğini aşıyor veya kazanç 0
+ */
+HAL_StatusTypeDef CurrentSense_Configure(uint16_t peak_ma, uint16_t average_ma,
+                                         uint16_t sw_trip_ms, uint16_t mv_per_a)
+{
+    if (mv_per_a == 0 || peak_ma == 0 || average_ma > peak_ma || sw_trip_ms == 0) return HAL_ERROR;
+
+    __disable_irq();
+    current_sense_config.peak_ma = peak_ma;
+    current_sense_config.average_ma = average_ma;
+    current_sense_config.sw_trip_ms = sw_trip_ms;
+    current_sense_config.mv_per_a = mv_per_a;
+    ma_per_lsb = CURRENT_SENSE_VREF_MV / (float)(CURRENT_SENSE_FULL + 1) * 1000.0f / (float)mv_per_a;
+    over_ms = 0;
+    __enable_irq();
+
+    CurrentSense_ApplyThreshold();
+    return HAL_OK;
+}
+
+/**
+ * @brief Tampon ortalaması, telemetri filtresi ve ortalama sınır - kontrol tick'inden (ISR)
+ */
+void CurrentSense_Tick(void)
+{
+    float ma = (CurrentSense_BufferMean() - (float)current_sense_status.offset) * ma_per_lsb;
+    if (ma < 0.0f) ma = 0.0f;
+
+    current_sense_status.average_ma = ma;
+    current_sense_status.filtered_ma += filter_alpha * (ma - current_sense_status.filtered_ma);
+    if (ma > current_sense_status.max_ma) current_sense_status.max_ma = ma;
+
+    if (current_sense_status.fault != CURRENT_TRIP_NONE) return;
+    if (ma > (float)current_sense_config.average_ma)
+    {
+        if (++over_ms >= current_sense_config.sw_trip_ms) CurrentSense_Trip(CURRENT_TRIP_AVERAGE);
+    }
+    else
+    {
+        over_ms = 0;
+    }
+}
+
+/**
+ * @brief ADC1 analog watchdog 1 - dönüşüm eşiği aştı
+ */
+void CurrentSense_WatchdogIRQ(void)
+{
+    CurrentSense_Trip(CURRENT_TRIP_PEAK);
+    ADC1->ISR = ADC_ISR_AWD1;
+}
+
+/**
+ * @brief Ana döngü - yeni hata için motoru süren tüm kaynakları durdurur
+ */
+void CurrentSense_Task(void)
+{
+    char msg[96];
+
+    if (current_sense_status.fault == CURRENT_TRIP_NONE || fault_handled) return;
+    fault_handled = 1;
+
+    MotionEvent_SetMotorEnabled(0);
+    MotorProfile_Cancel(MOTOR_MAIN);
+    MotorWave_Stop();
+    MotorQueue_Flush();
+    Pid_Enable(0);
+
+    sprintf(msg, "!! ASIRI AKIM (%s) %.0fmA - motor kesildi, ICLR ile devam\r\n",
+            trip_names[current_sense_status.fault], current_sense_status.average_ma);
+    SendDebugMessage(msg);
+}
+
+uint8_t CurrentSense_IsFaulted(void)
+{
+    return current_sense_status.fault != CURRENT_TRIP_NONE;
+}
+
+/**
+ * @brief Kilitli hatayı temizler - compare 0'a yüklenip PWM kipi geri açılır
+ */
+void CurrentSense_ClearFault(void)
+{
+    __disable_irq();
+    HW153_WritePulse(0);
+
+    // Preload'u hemen yükle: eski compare ile tek periyot bile sürülmesin
+    TIM3->CR1 |= TIM_CR1_URS;
+    TIM3->EGR = TIM_EGR_UG;
+    TIM3->CR1 &= ~TIM_CR1_URS;
+    TIM3->CCMR1 = (TIM3->CCMR1 & ~(TIM_CCMR1_OC1M | TIM_CCMR1_OC2M)) |
+                  TIM_OCMODE_PWM1 | (TIM_OCMODE_PWM1 << 8);
+
+    current_sense_status.fault = CURRENT_TRIP_NONE;
+    over_ms = 0;
+    fault_handled = 0;
+    ADC1->ISR = ADC_ISR_AWD1;
+    ADC1->IER |= ADC_IER_AWD1IE;
+    __enable_irq();
+}
+
+void CurrentSense_Report(void)
+{
+    char msg[160];
+    float latency_us = (float)current_sense_status.trip_latency_cycles * 1e6f / (float)SystemCoreClock;
+
+    sprintf(msg, "Cur[%.0fmA Avg:%.0f Max:%.0f Ofs:%u Lim:%u/%umA %ums %umV/A Fault:%s Trip:%lu/%lu Lat:%.2fus]\r\n",
+            current_sense_status.filtered_ma, current_sense_status.average_ma, current_sense_status.max_ma,
+            current_sense_status.offset, current_sense_config.peak_ma, current_sense_config.average_ma,
+            current_sense_config.sw_trip_ms, current_sense_config.mv_per_a,
+            trip_names[current_sense_status.fault], current_sense_status.peak_trips,
+            current_sense_status.average_trips, latency_us);
+    SendDebugMessage(msg);
+    current_sense_status.max_ma = 0.0f;
+}
@@ -0,0 +1,193 @@
+#include "encoder.h"
+#include "motor.h"
+#include "tim.h"
+#include "timebase.h"
+#include <stdio.h>
+#include <string.h>
+
+Encoder_Config_t encoder_config;
+volatile Encoder_Status_t encoder_status;
+
+static volatile int32_t extended = 0;       // 32 bit genişletilmiş sayım
+static uint16_t last_cnt = 0;
+
+// Tick geçmişi - pencere yöntemi
+static int32_t hist_count[ENCODER_HISTORY];
+static uint32_t hist_time[ENCODER_HISTORY];
+static uint8_t hist_index = 0;
+static uint8_t hist_fill = 0;
+
+// Sayımın değiştiği son tick'ler - kenar aralığı yöntemi
+static int32_t edge_count[ENCODER_PERIOD_EDGES + 1];
+static uint32_t edge_time[ENCODER_PERIOD_EDGES + 1];
+static uint8_t edge_index = 0;
+static uint8_t edge_fill = 0;
+
+/**
+ * @brief Geçmişi sıfırlar - kip değişince ve başlangıçta
+ */
+static void Encoder_ResetState(void)
+{
+    last_cnt = (uint16_t)TIM1->CNT;
+    hist_fill = 0;
+    edge_fill = 0;
+    encoder_status.rpm = 0.0f;
+    encoder_status.stalled = 0;
+}
+
+/**
+ * @brief TIM1 slave kipini seçer: encoder (TI1+TI2) veya TI1 harici saat
+ */
+static void Encoder_ApplyMode(Encoder_Mode_t mode)
+{
+    uint32_t smcr = TIM1->SMCR & ~(TIM_SMCR_SMS | TIM_SMCR_TS);
+
+    if (mode == ENCODER_QUADRATURE) smcr |= TIM_ENCODERMODE_TI12;
+    else smcr |= TIM_SLAVEMODE_EXTERNAL1 | TIM_TS_TI1FP1;
+    TIM1->SMCR = smcr;
+}
+
+/**
+ * @brief Varsayılan: quadrature, 48 sayım/tur, 20 ms pencere, 250 ms takılma
+ */
+void Encoder_Init(void)
+{
+    encoder_config.mode = ENCODER_QUADRATURE;
+    encoder_config.counts_per_rev = 48;
+    encoder_config.window_ms = 20;
+    encoder_config.stall_ms = 250;
+    memset((void*)&encoder_status, 0, sizeof(encoder_status));
+    extended = 0;
+
+    HAL_TIM_Encoder_Start(&htim1, TIM_CHANNEL_ALL);
+    Encoder_ApplyMode(encoder_config.mode);
+    Encoder_ResetState();
+}
+
+/**
+ * @brief Kip ve hız hesabı parametreleri
+ * @retval HAL_ERROR: geçersiz parametre
+ */
+HAL_StatusTypeDef Encoder_Configure(Encoder_Mode_t mode, uint16_t counts_per_rev,
+                                    uint16_t window_ms, uint16_t stall_ms)
+{
+    if (mode >= ENCODER_MODE_COUNT || counts_per_rev == 0) return HAL_ERROR;
+    if (window_ms == 0 || window_ms >= ENCODER_HISTORY || stall_ms <= window_ms) return HAL_ERROR;
+
+    __disable_irq();
+    encoder_config.mode = mode;
+    encoder_config.counts_per_rev = counts_per_rev;
+    encoder_config.window_ms = window_ms;
+    encoder_config.stall_ms = stall_ms;
+    Encoder_ApplyMode(mode);
+    Encoder_ResetState();
+    __enable_irq();
+    return HAL_OK;
+}
+
+static float Encoder_ToRpm(int32_t counts, uint32_t cycles)
+{
+    if (cycles == 0) return 0.0f;
+    return (float)counts * 60.0f * (float)SystemCoreClock /
+           ((float)cycles * (float)encoder_config.counts_per_rev);
+}
+
+/**
+ * @brief Sayımı genişletir ve hızı günceller - kontrol tick'inden (ISR), PID'den önce
+ */
+void Encoder_Tick(void)
+{
+    uint32_t now = Timebase_Cycles();
+    uint16_t cnt = (uint16_t)TIM1->CNT;
+    int16_t delta = (int16_t)(cnt - last_cnt);
+    int32_t drive = HW153_GetPulse();
+
+    last_cnt = cnt;
+    if (encoder_config.mode == ENCODER_TACH && drive < 0) delta = -delta;    // Tako yönsüz
+    extended += delta;
+
+    hist_index = (uint8_t)((hist_index + 1) % ENCODER_HISTORY);
+    hist_count[hist_index] = extended;
+    hist_time[hist_index] = now;
+    if (hist_fill < ENCODER_HISTORY) hist_fill++;
+
+    if (delta != 0)
+    {
+        edge_index = (uint8_t)((edge_index + 1) % (ENCODER_PERIOD_EDGES + 1));
+        edge_count[edge_index] = extended;
+        edge_time[edge_index] = now;
+        if (edge_fill < ENCODER_PERIOD_EDGES + 1) edge_fill++;
+    }
+
+    uint32_t stall_cycles = (SystemCoreClock / 1000U) * encoder_config.stall_ms;
+    uint8_t moving = (edge_fill > 0) && (now - edge_time[edge_index] <= stall_cycles);
+    float rpm = 0.0f;
+
+    if (moving)
+    {
+        uint32_t span = (encoder_config.window_ms < hist_fill) ? encoder_config.window_ms : (uint32_t)(hist_fill - 1);
+        uint8_t old = (uint8_t)((hist_index + ENCODER_HISTORY - span) % ENCODER_HISTORY);
+        int32_t counts = extended - hist_count[old];
+
+        if (counts >= ENCODER_MIN_COUNTS || counts <= -ENCODER_MIN_COUNTS)
+        {
+            // Pencere ortalaması: sayım / süre
+            rpm = Encoder_ToRpm(counts, now - hist_time[old]);
+        }
+        else if (edge_fill >= 2)
+        {
+            // Yavaş: son kenar aralıklarının ortalaması
+            uint8_t first = (uint8_t)((edge_index + (ENCODER_PERIOD_EDGES + 1) - (edge_fill - 1)) % (ENCODER_PERIOD_EDGES + 1));
+            int32_t edge_counts = edge_count[edge_index] - edge_count[first];
+            uint32_t period = edge_time[edge_index] - edge_time[first];
+            uint32_t since = now - edge_time[edge_index];
+            // Son kenardan beri geçen süre ortalamayı aşıyorsa yavaşlama var - hız ona göre düşer
+            uint32_t per_edge = period / (uint32_t)(edge_fill - 1);
+            if (since > per_edge) period += since - per_edge;
+            rpm = Encoder_ToRpm(edge_counts, period);
+            encoder_status.period_estimates++;
+        }
+    }
+    else
+    {
+        edge_fill = 0;      // Durdu - bir sonraki hareket eski kenarlarla karışmasın
+    }
+
+    encoder_status.rpm = rpm;
+
+    uint8_t stalled = !moving && drive != 0;
+    if (stalled && !encoder_status.stalled) encoder_status.stalls++;
+    encoder_status.stalled = stalled;
+}
+
+/**
+ * @brief 32 bit sayım - ana döngüden, son tick'ten sonraki sayımlar dahil
+ */
+int32_t Encoder_GetCount(void)
+{
+    __disable_irq();
+    int16_t delta = (int16_t)((uint16_t)TIM1->CNT - last_cnt);
+    int32_t count = extended;
+    __enable_irq();
+
+    if (encoder_config.mode == ENCODER_TACH && HW153_GetPulse() < 0) delta = -delta;
+    return count + delta;
+}
+
+float Encoder_GetRpm(void)
+{
+    return encoder_status.rpm;
+}
+
+void Encoder_Report(void)
+{
+    char msg[128];
+
+    sprintf(msg, "RPM[%.1f Cnt:%ld %s CPR:%u Win:%ums Stall:%s (%lu) Per:%lu]\r\n",
+            encoder_status.rpm, Encoder_GetCount(),
+            encoder_config.mode == ENCODER_QUADRATURE ? "QUAD" : "TACH",
+            encoder_config.counts_per_rev, encoder_config.window_ms,
+            encoder_status.stalled ? "YES" : "no", encoder_status.stalls,
+            encoder_status.period_estimates);
+    SendDebugMessage(msg);
+}
@@ -0,0 +1,84 @@
+#include "flash_store.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t magic;
+    uint16_t length;
+    uint16_t crc;
+} FlashStore_Header_t;
+
+/* CRC-16/CCITT-FALSE - ACFG blob'u ile aynı */
+static uint16_t FlashStore_Crc16(const uint8_t* data, uint16_t len)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Kaydı okur
+ * @retval HAL_ERROR: kayıt yok, uzunluk farklı (yapı değişmiş) veya crc tutmuyor
+ */
+HAL_StatusTypeDef FlashStore_Load(void* data, uint16_t len)
+{
+    const FlashStore_Header_t* h = (const FlashStore_Header_t*)FLASH_STORE_ADDR;
+    const uint8_t* payload = (const uint8_t*)(FLASH_STORE_ADDR + sizeof(FlashStore_Header_t));
+
+    if (h->magic != FLASH_STORE_MAGIC || h->length != len) return HAL_ERROR;
+    if (FlashStore_Crc16(payload, len) != h->crc) return HAL_ERROR;
+
+    memcpy(data, payload, len);
+    return HAL_OK;
+}
+
+/**
+ * @brief Sayfayı siler ve kaydı yazar - ana döngüden, motor dururken
+ */
+HAL_StatusTypeDef FlashStore_Save(const void* data, uint16_t len)
+{
+    FLASH_EraseInitTypeDef erase = {0};
+    FlashStore_Header_t h;
+    uint32_t page_error = 0;
+    uint32_t addr = FLASH_STORE_ADDR;
+    HAL_StatusTypeDef status;
+
+    if (len == 0 || len > FLASH_STORE_MAX) return HAL_ERROR;
+
+    h.magic = FLASH_STORE_MAGIC;
+    h.length = len;
+    h.crc = FlashStore_Crc16((const uint8_t*)data, len);
+
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.PageAddress = FLASH_STORE_ADDR;
+    erase.NbPages = 1;
+
+    HAL_FLASH_Unlock();
+    status = HAL_FLASHEx_Erase(&erase, &page_error);
+
+    // Başlık, sonra veri yarım word'ler halinde (tek uzunlukta son byte 0xFF ile tamamlanır)
+    for (uint16_t i = 0; status == HAL_OK && i < sizeof(h); i += 2)
+    {
+        uint16_t hw;
+        memcpy(&hw, (const uint8_t*)&h + i, 2);
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, addr, hw);
+        addr += 2;
+    }
+    for (uint16_t i = 0; status == HAL_OK && i < len; i += 2)
+    {
+        uint16_t hw = 0xFFFF;
+        memcpy(&hw, (const uint8_t*)data + i, (len - i >= 2) ? 2 : 1);
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, addr, hw);
+        addr += 2;
+    }
+    HAL_FLASH_Lock();
+
+    return status;
+}
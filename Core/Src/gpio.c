@@ -29,26 +29,20 @@ void MX_GPIO_Init(void)
   __HAL_RCC_GPIOF_CLK_ENABLE();
   __HAL_RCC_GPIOA_CLK_ENABLE();
   __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_GPIOD_CLK_ENABLE();
 
   /* Configure GPIO pins */
   
-  // HW-153 V1 Motor Driver - PA6 (INA/PWM) için TIM3_CH1
-  GPIO_InitStruct.Pin = GPIO_PIN_6;  // PA6 - PWM/Speed Control
-  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
-  GPIO_InitStruct.Pull = GPIO_NOPULL;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-  GPIO_InitStruct.Alternate = GPIO_AF2_TIM3;
-  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+  // HW-153 V1 Motor Driver pinleri (PC6/PC7) HAL_TIM_MspPostInit'te TIM3 AF olarak ayarlanır
+  // PA6/PA7 SPI1'e aittir (HAL_SPI_MspInit)
 
-  // HW-153 V1 Motor Driver - PA7 (INB) Direction Control
-  GPIO_InitStruct.Pin = GPIO_PIN_7;  // PA7 - Direction Control
+  // M2/M3 yön pinleri - PD10/PD11, başlangıçta ileri
+  HAL_GPIO_WritePin(GPIOD, MOTOR2_DIR_PIN | MOTOR3_DIR_PIN, GPIO_PIN_RESET);
+  GPIO_InitStruct.Pin = MOTOR2_DIR_PIN | MOTOR3_DIR_PIN;
   GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
-  
-  // Motor başlangıçta durdurulmuş olsun
-  HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_RESET);
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  HAL_GPIO_Init(GPIOD, &GPIO_InitStruct);
 
   // L3GD20 Gyroscope CS Pin - PE3
   GPIO_InitStruct.Pin = GPIO_PIN_3;  // PE3 - L3GD20 CS (Chip Select)
@@ -0,0 +1,104 @@
+#include "gyro_bias.h"
+#include <math.h>
+#include <stdio.h>
+
+GyroBias_t gyro_bias;
+
+/**
+ * @brief Bias tahminini sıfırlar
+ * @param accel_ok: 1=İvmeölçer çalışıyor (still tespiti mümkün), 0=Sadece predict
+ */
+void GyroBias_Init(uint8_t accel_ok)
+{
+    memset(&gyro_bias, 0, sizeof(gyro_bias));
+    gyro_bias.P = GYRO_BIAS_P0;
+    gyro_bias.accel_ok = accel_ok;
+}
+
+/**
+ * @brief Acquisition path: bias tahminini günceller ve ölçümden çıkarır
+ * @param data: Ham gyro verisi (dps) - düzeltilmiş değerlerle üzerine yazılır
+ * @param acc: Aynı andaki ivme (g)
+ */
+void GyroBias_Process(L3GD20_Data_t* data, const float acc[3])
+{
+    GyroBias_t* gb = &gyro_bias;
+    float raw[3] = {data->x, data->y, data->z};
+    float cx = raw[0] - gb->bias[0];
+    float cy = raw[1] - gb->bias[1];
+    float cz = raw[2] - gb->bias[2];
+
+    // Predict: bias random walk
+    gb->P += GYRO_BIAS_Q;
+    gb->samples++;
+
+    if (gb->accel_ok)
+    {
+        // Hareketsiz: |a| ≈ 1g, ivme ve ham hız sabit (ofsetten bağımsız)
+        float a2 = acc[0] * acc[0] + acc[1] * acc[1] + acc[2] * acc[2];
+        uint8_t still = (fabsf(a2 - 1.0f) < GYRO_BIAS_ACC_TOL_G2) &&
+                        (fabsf(acc[0] - gb->last_acc[0]) < GYRO_BIAS_ACC_DELTA_G) &&
+                        (fabsf(acc[1] - gb->last_acc[1]) < GYRO_BIAS_ACC_DELTA_G) &&
+                        (fabsf(acc[2] - gb->last_acc[2]) < GYRO_BIAS_ACC_DELTA_G) &&
+                        (fabsf(raw[0] - gb->last_raw[0]) < GYRO_BIAS_GYRO_DELTA_DPS) &&
+                        (fabsf(raw[1] - gb->last_raw[1]) < GYRO_BIAS_GYRO_DELTA_DPS) &&
+                        (fabsf(raw[2] - gb->last_raw[2]) < GYRO_BIAS_GYRO_DELTA_DPS);
+
+        // Düzeltilmiş hız kapısı - belirsizlikle daralır: yerçekimi ekseni etrafında sabit dönüş still değil
+        float gate2 = GYRO_BIAS_GYRO_GATE_DPS * GYRO_BIAS_GYRO_GATE_DPS + GYRO_BIAS_GATE_SIGMA * GYRO_BIAS_GATE_SIGMA * gb->P;
+        uint8_t in_gate = (cx * cx + cy * cy + cz * cz < gate2);
+
+        // Kart hareketsiz görünüyor ama kapı sürekli reddediyor: bias kaymış, belirsizlik yeniden açılır
+        gb->gate_rejects = (still && !in_gate) ? gb->gate_rejects + 1 : 0;
+        if (gb->gate_rejects >= GYRO_BIAS_REOPEN_COUNT)
+        {
+            gb->P = GYRO_BIAS_P0;
+            gb->gate_rejects = 0;
+            gb->reopens++;
+        }
+        still = still && in_gate;
+
+        for (int i = 0; i < 3; i++)
+        {
+            gb->last_acc[i] = acc[i];
+            gb->last_raw[i] = raw[i];
+        }
+
+        gb->still_count = still ? gb->still_count + 1 : 0;
+
+        if (GyroBias_IsStill())
+        {
+            // Update: ortak kazanç, eksen başına tek çarp-topla
+            float k = gb->P / (gb->P + GYRO_BIAS_R);
+            gb->bias[0] += k * (raw[0] - gb->bias[0]);
+            gb->bias[1] += k * (raw[1] - gb->bias[1]);
+            gb->bias[2] += k * (raw[2] - gb->bias[2]);
+            gb->P -= k * gb->P;
+            gb->updates++;
+
+            cx = raw[0] - gb->bias[0];
+            cy = raw[1] - gb->bias[1];
+            cz = raw[2] - gb->bias[2];
+        }
+    }
+
+    data->x = cx;
+    data->y = cy;
+    data->z = cz;
+    float sq = cx * cx + cy * cy + cz * cz;
+    data->magnitude = sqrtf(sq);
+    // Düzeltilmiş büyüklüğün karesi ham LSB² cinsinden (motor eğrisi indeksi)
+    data->mag2 = (uint32_t)(sq * (1.0f / (L3GD20_DPS_PER_LSB * L3GD20_DPS_PER_LSB)));
+}
+
+/**
+ * @brief Bias durumunu UART'a yazar (vardiya boyunca drift takibi için)
+ */
+void GyroBias_Report(void)
+{
+    char msg[128];
+    sprintf(msg, "Bias[X:%.4f Y:%.4f Z:%.4f] P:%.2e Still:%lu Upd:%lu/%lu Reopen:%lu\r\n",
+            gyro_bias.bias[0], gyro_bias.bias[1], gyro_bias.bias[2], gyro_bias.P,
+            gyro_bias.still_count, gyro_bias.updates, gyro_bias.samples, gyro_bias.reopens);
+    SendDebugMessage(msg);
+}
@@ -20,7 +20,11 @@ extern char debugMsg[UART_BUFFER_SIZE];  // From main.c
 #define OUT_Z_L_A                 0x2C
 #define OUT_Z_H_A                 0x2D
 
+// ±2g, high-resolution: 12-bit sola dayalı veri, 1mg/LSB
+#define ACCEL_RAW_TO_G(raw)       ((float)((raw) >> 4) * 0.001f)
+
 // Global variables
+static uint8_t accel_addr = LSM303DLHC_ACCEL_ADDR;  // Init'te bulunan adres
 volatile float accel_x = 0;
 volatile float accel_y = 0;
 volatile float accel_z = 0;
@@ -60,8 +64,8 @@ HAL_StatusTypeDef LSM303DLHC_Init(void)
     // Basit başlatma - sadece gerekli register'lar
     HAL_Delay(100); // Sensörün hazır olması için bekle
     
-    // CTRL_REG1_A: Normal mode, 10Hz, XYZ enabled (daha düşük frekans)
-    data = 0x27;  // 0010 0111b - 10Hz, normal mode, XYZ enabled
+    // CTRL_REG1_A: Normal mode, 100Hz, XYZ enabled (örnekleme periyoduyla aynı)
+    data = 0x57;  // 0101 0111b - 100Hz, normal mode, XYZ enabled
     status = HAL_I2C_Mem_Write(&hi2c1, working_addr, CTRL_REG1_A, 1, &data, 1, 2000);
     if (status != HAL_OK) {
         sprintf(debugMsg, "CTRL_REG1_A write failed: %d\r\n", status);
@@ -71,8 +75,8 @@ HAL_StatusTypeDef LSM303DLHC_Init(void)
     
     HAL_Delay(50);
     
-    // CTRL_REG4_A: ±2g, normal resolution
-    data = 0x00;  // 0000 0000b - ±2g, normal resolution
+    // CTRL_REG4_A: ±2g, high resolution
+    data = 0x08;  // 0000 1000b - ±2g, HR=1 (12-bit)
     status = HAL_I2C_Mem_Write(&hi2c1, working_addr, CTRL_REG4_A, 1, &data, 1, 2000);
     if (status != HAL_OK) {
         sprintf(debugMsg, "CTRL_REG4_A write failed: %d\r\n", status);
@@ -89,6 +93,8 @@ HAL_StatusTypeDef LSM303DLHC_Init(void)
         SendDebugMessage(debugMsg);
     }
     
+    accel_addr = working_addr;
+
     sprintf(debugMsg, "LSM303DLHC init completed with address: 0x%02X\r\n", working_addr);
     SendDebugMessage(debugMsg);
     
@@ -102,7 +108,7 @@ HAL_StatusTypeDef LSM303DLHC_ReadAccel(void)
     HAL_StatusTypeDef status;
     
     // Read all acceleration registers at once (X, Y, Z)
-    status = HAL_I2C_Mem_Read(&hi2c1, LSM303DLHC_ACCEL_ADDR, OUT_X_L_A | 0x80, 1, data, 6, 1000);
+    status = HAL_I2C_Mem_Read(&hi2c1, accel_addr, OUT_X_L_A | 0x80, 1, data, 6, 1000);
     if (status != HAL_OK) return status;
     
     // Combine high and low bytes
@@ -111,10 +117,10 @@ HAL_StatusTypeDef LSM303DLHC_ReadAccel(void)
     raw_z = (int16_t)((data[5] << 8) | data[4]);
     
     // Convert to g (±2g range)
-    // LSB sensitivity = 1mg/LSB = 0.001g/LSB
-    accel_x = (float)raw_x * 0.001f;
-    accel_y = (float)raw_y * 0.001f;
-    accel_z = (float)raw_z * 0.001f;
+    // LSB sensitivity = 1mg/LSB = 0.001g/LSB (12-bit, sola dayalı)
+    accel_x = ACCEL_RAW_TO_G(raw_x);
+    accel_y = ACCEL_RAW_TO_G(raw_y);
+    accel_z = ACCEL_RAW_TO_G(raw_z);
     
     return HAL_OK;
 }
@@ -125,7 +131,7 @@ void LSM303DLHC_Read_All(LSM303DLHC_t *DataStruct)
     HAL_StatusTypeDef status;
     
     // 6 byte veriyi oku (X, Y, Z low ve high byte'ları)
-    status = HAL_I2C_Mem_Read(&hi2c1, LSM303DLHC_ACCEL_ADDR, 
+    status = HAL_I2C_Mem_Read(&hi2c1, accel_addr, 
                              OUT_X_L_A | 0x80, 
                              I2C_MEMADD_SIZE_8BIT, data, 6, 1000);
     
@@ -142,9 +148,9 @@ void LSM303DLHC_Read_All(LSM303DLHC_t *DataStruct)
     DataStruct->z = (int16_t)(data[5] << 8 | data[4]);
     
     // ±2g için dönüşüm faktörü: 1mg/LSB
-    DataStruct->x_g = (float)(DataStruct->x) * 0.001f;
-    DataStruct->y_g = (float)(DataStruct->y) * 0.001f;
-    DataStruct->z_g = (float)(DataStruct->z) * 0.001f;
+    DataStruct->x_g = ACCEL_RAW_TO_G(DataStruct->x);
+    DataStruct->y_g = ACCEL_RAW_TO_G(DataStruct->y);
+    DataStruct->z_g = ACCEL_RAW_TO_G(DataStruct->z);
     
     // Debug mesajları
     sprintf(debugMsg, "Raw: X=%d Y=%d Z=%d\r\n", DataStruct->x, DataStruct->y, DataStruct->z);
@@ -8,6 +8,7 @@
 /* USER CODE END Header */
 
 #include "main.h"
+#include "dma.h"
 #include "tim.h"
 #include "usart.h"
 #include "gpio.h"
@@ -17,37 +18,53 @@
 #include <stdio.h>
 #include <math.h>
 #include "motor.h"
+#include "L3GD20.h"
+#include "LSM303DLHC.h"
+#include "gyro_bias.h"
+#include "angle.h"
+#include "timebase.h"
+#include "command.h"
+#include "motion_event.h"
+#include "motion_stats.h"
+#include "spectrum.h"
+#include "activity.h"
+#include "control.h"
+#include "pid.h"
+#include "motor_profile.h"
+#include "motor_queue.h"
+#include "motor_wave.h"
+#include "motor_curve.h"
+#include "motor_output.h"
+#include "encoder.h"
+#include "current_sense.h"
+#include "motor_stop.h"
+#include "motor_ident.h"
+#include "pid_tune.h"
+#include "rate_predict.h"
+#include "sample_sync.h"
+#include "uart_tx.h"
 
 // --- Definitions ---
-typedef struct {
-    float x;
-    float y;
-    float z;
-    float magnitude;
-} L3GD20_Data_t;
-
-#define UART_BUFFER_SIZE 256
-#define RX_BUFFER_SIZE 64
+#define SAMPLE_PERIOD_MS  10   // Gyro/ivme örnekleme periyodu (100Hz)
+#define REPORT_PERIOD_MS  500  // Motor/LED/terminal güncelleme periyodu
+#define BIAS_REPORT_EVERY 10   // Rapor sayısı (500ms x 10 = 5s)
 
 // --- Global Variables ---
 L3GD20_Data_t gyro_data;
 uint8_t current_motor_speed = 0;
 uint32_t loop_counter = 0;
+uint32_t last_sample_tick = 0;
+uint32_t last_report_tick = 0;
+uint32_t last_stats_tick = 0;
 char uart_msg[UART_BUFFER_SIZE];
 
 volatile uint8_t motorSpeed = 0;
 char debugMsg[UART_BUFFER_SIZE];
-uint8_t rxBuffer[RX_BUFFER_SIZE];  // RX_BUFFER_SIZE main.h içinde 64 olarak tanımlanmalı
+uint8_t rxBuffer[RX_BUFFER_SIZE];
 
 // --- Function Prototypes ---
 void SystemClock_Config(void);
 void SendDebugMessage(const char* message);
-void L3GD20_Init(void);
-void L3GD20_ReadData(L3GD20_Data_t* data);
-uint8_t L3GD20_ReadRegister(uint8_t reg);
-void L3GD20_WriteRegister(uint8_t reg, uint8_t value);
-uint8_t L3GD20_CalculateMotorSpeed(L3GD20_Data_t* gyro_data);
-void L3GD20_DisplayOnTerminal(L3GD20_Data_t* gyro_data, uint8_t motor_speed);
 
 // LED Functions - STM32F3 Discovery LEDs
 void LED_Init_All(void);
@@ -55,27 +72,49 @@ void LED_Set_All(uint8_t state);
 void LED_Rainbow_Effect(void);
 void LED_Speed_Display(uint8_t speed);
 void LED_Gyro_Effect(L3GD20_Data_t* gyro_data);
+void Sample_Process(void);
+static uint8_t Motor_MapOwnsOutput(void);
 
-// Motor functions from motor.c
-void HW153_SetMotor(uint8_t speed, uint8_t direction);
-#define MOTOR_DIRECTION_FORWARD  1
-#define MOTOR_DIRECTION_BACKWARD 0
 
 int main(void)
 {
    HAL_Init();
   SystemClock_Config();
+  Timebase_Init();
   MX_GPIO_Init();
+  MX_DMA_Init();
+  MX_TIM1_Init();
+  MX_TIM2_Init();
   MX_TIM3_Init();
+  MX_TIM4_Init();
+  MX_TIM6_Init();
   MX_USART2_UART_Init();
   MX_SPI1_Init();
   MX_I2C1_Init();
+  UartTx_Init();  // USART2 DMA gönderim tamponu
 
   HAL_Delay(1000);
-  HAL_UART_Transmit(&huart2, (uint8_t*)"STM32 Başlatıldı\r\n", 21, HAL_MAX_DELAY);
+  SendDebugMessage("STM32 Başlatıldı\r\n");
 
   Motor_Init();
   L3GD20_Init();
+  GyroBias_Init(LSM303DLHC_Init() == HAL_OK);
+  Angle_Reset();
+  MotionEvent_Init();
+  MotionStats_Init();
+  Spectrum_Init();
+  Activity_Init();
+  Pid_Init();  // Flash'ta kayıt varsa kazançlar oradan
+  PidTune_Init();
+  RatePredict_Init();
+  SampleSync_Init();
+  MotorCurve_Init();
+  MotorOutput_Init();
+  Encoder_Init();
+  CurrentSense_Init();  // ADC1 + DMA, motor dururken sıfır noktası
+  MotorStop_Init();
+  MotorIdent_Init();
+  Command_Init();
   LED_Init_All();  // Tüm LED'leri başlat
 
   // Startup LED Show! 🌈
@@ -83,14 +122,63 @@ int main(void)
     LED_Rainbow_Effect();
     HAL_Delay(200);
   }
+
+  MotorQueue_Init();  // µs zamanlı komut kuyruğu (TIM2)
+  Control_Init();  // 1 kHz kontrol tick'i (TIM6)
   
-  HAL_UART_Transmit(&huart2, (uint8_t*)"🌈 LED Show Tamamlandı! 🎉\r\n", 35, HAL_MAX_DELAY);
+  SendDebugMessage("🌈 LED Show Tamamlandı! 🎉\r\n");
 
   while (1)
   {
-    L3GD20_ReadData(&gyro_data);
-    current_motor_speed = L3GD20_CalculateMotorSpeed(&gyro_data);
-    HW153_SetMotor(current_motor_speed, MOTOR_DIRECTION_FORWARD);
+    uint32_t now = HAL_GetTick();
+
+    Command_Poll();
+    CurrentSense_Task();
+    MotorStop_Task();
+    MotorIdent_Task();
+    PidTune_Task();
+    RatePredict_Task();
+    SampleSync_Task();
+
+    // Sabit periyotlu örnekleme - entegrasyon gerçek dt ile yapılır
+    if (now - last_sample_tick >= SAMPLE_PERIOD_MS)
+    {
+        last_sample_tick = now;
+        SampleSync_Wait();      // Senkron kipte PWM fazına kadar bekler
+        Sample_Process();
+    }
+
+    // FFT hesabı arka planda, tur başına bir adım
+    Spectrum_Task();
+
+    // Pencere istatistikleri ve spektrum - düşük hızda
+    if (now - last_stats_tick >= MOTION_STATS_REPORT_MS)
+    {
+        last_stats_tick = now;
+        MotionStats_Report();
+        Spectrum_Report();
+        Encoder_Report();
+        CurrentSense_Report();
+        if (Pid_IsEnabled())
+        {
+            Pid_Report();
+            Control_Report();
+        }
+        else if (Motor_MapOwnsOutput())
+        {
+            MotorOutput_Report();
+        }
+    }
+
+    if (now - last_report_tick < REPORT_PERIOD_MS)
+    {
+        continue;
+    }
+    last_report_tick = now;
+
+    // Hız haritası örnekleme hızında koşullandırıcıdan uygulanır (Sample_Process)
+    motorSpeed = MotorChannel_GetPercent(MOTOR_MAIN);
+    current_motor_speed = motorSpeed;
 
     // LED Effects! ✨
     LED_Speed_Display(current_motor_speed);  // Motor hızına göre LED'ler
@@ -105,14 +193,75 @@ int main(void)
             gyro_data.x, gyro_data.y, gyro_data.z, gyro_data.magnitude, current_motor_speed);
     SendDebugMessage(uart_msg);
 
+    Angle_Report();
+
+    if (loop_counter % BIAS_REPORT_EVERY == 0)
+    {
+        GyroBias_Report();
+    }
+
     loop_counter++;
-    HAL_Delay(500);
   }
 }
 
+/**
+ * @brief Acquisition path: gyro + ivme oku, bias düzelt, açıya entegre et
+ */
+void Sample_Process(void)
+{
+    L3GD20_ReadData(&gyro_data);
+
+    // Online bias takibi - ivmeölçer hareketsiz derse güncellenir
+    float acc[3] = {0.0f, 0.0f, 0.0f};
+    uint8_t acc_ok = 0;
+    if (gyro_bias.accel_ok && LSM303DLHC_ReadAccel() == HAL_OK) {
+        acc[0] = accel_x;
+        acc[1] = accel_y;
+        acc[2] = accel_z;
+        acc_ok = 1;
+    }
+    SampleSync_NoiseSample(&gyro_data, acc, acc_ok);
+    GyroBias_Process(&gyro_data, acc);
+
+    Angle_Update(&gyro_data, GyroBias_IsStill());
+    RatePredict_Update(&gyro_data);
+    Pid_UpdateSensors(&gyro_data, angle_state.angle);
+    MotionEvent_Process(&gyro_data, acc, HAL_GetTick());
+    MotionStats_Update(&gyro_data, HAL_GetTick());
+    Spectrum_AddSample(&gyro_data);
+    Activity_Update(&gyro_data, acc, acc_ok, HAL_GetTick());
+    MotorStop_GyroSample(gyro_data.magnitude);
+
+    // Büyüklük -> eğri tablosu -> koşullandırıcı (ölü bölge, eğim, sadece değişimde yaz)
+    if (Motor_MapOwnsOutput())
+    {
+        MotorOutput_Update(MotorCurve_Lookup(gyro_data.mag2));
+        RatePredict_MarkOutput();
+    }
+    else
+    {
+        MotorOutput_Release();
+    }
+}
+
+/**
+ * @brief Profil (olay/komut), dalga, zamanlı kuyruk veya PID motoru sürerken
+ *        ya da aşırı akım hatası kilitliyken/durma süresi ölçülürken/sistem tanıma kaydı
+ *        veya röle ayarı sürerken hız haritası uygulanmaz
+ */
+static uint8_t Motor_MapOwnsOutput(void)
+{
+    return !(MotorProfile_IsActive(MOTOR_MAIN) || MotorWave_IsActive() || MotorQueue_Depth() > 0 || Pid_IsEnabled() ||
+             CurrentSense_IsFaulted() || MotorStop_IsMeasuring() || MotorIdent_IsRunning() ||
+             PidTune_IsRunning());
+}
+
+/**
+ * @brief Mesajı DMA gönderim tamponuna kopyalar, beklemez - tampon doluysa atılır
+ */
 void SendDebugMessage(const char* message)
 {
-    HAL_UART_Transmit(&huart2, (uint8_t*)message, strlen(message), HAL_MAX_DELAY);
+    UartTx_Write((const uint8_t*)message, (uint16_t)strlen(message));
 }
 
 void L3GD20_Init(void)
@@ -130,6 +279,7 @@ void L3GD20_ReadData(L3GD20_Data_t* data)
     uint8_t buffer[6];
     int16_t raw_x, raw_y, raw_z;
 
+    data->timestamp = Timebase_Cycles();
     buffer[0] = L3GD20_ReadRegister(0x28);
     buffer[1] = L3GD20_ReadRegister(0x29);
     buffer[2] = L3GD20_ReadRegister(0x2A);
@@ -141,9 +291,11 @@ void L3GD20_ReadData(L3GD20_Data_t* data)
     raw_y = (int16_t)((buffer[3] << 8) | buffer[2]);
     raw_z = (int16_t)((buffer[5] << 8) | buffer[4]);
 
-    data->x = (float)raw_x * 0.00875f;
-    data->y = (float)raw_y * 0.00875f;
-    data->z = (float)raw_z * 0.00875f;
+    data->x = (float)raw_x * L3GD20_DPS_PER_LSB;
+    data->y = (float)raw_y * L3GD20_DPS_PER_LSB;
+    data->z = (float)raw_z * L3GD20_DPS_PER_LSB;
+    data->mag2 = (uint32_t)((int32_t)raw_x * raw_x) + (uint32_t)((int32_t)raw_y * raw_y) +
+                 (uint32_t)((int32_t)raw_z * raw_z);
 
     data->magnitude = sqrtf(data->x * data->x + data->y * data->y + data->z * data->z);
 }
@@ -171,10 +323,8 @@ void L3GD20_WriteRegister(uint8_t reg, uint8_t value)
 
 uint8_t L3GD20_CalculateMotorSpeed(L3GD20_Data_t* gyro_data)
 {
-    float magnitude = gyro_data->magnitude;
-    if (magnitude < 0.5f) return 0;
-    if (magnitude > 10.0f) return 100;
-    return (uint8_t)(((magnitude - 0.5f) / 9.5f) * 100);
+    // Transfer eğrisi tablosu: kaydırma + okuma, bölme/karekök yok
+    return (uint8_t)(MotorCurve_Lookup(gyro_data->mag2) / (MOTOR_DUTY_FULL / 100));
 }
 
 void L3GD20_DisplayOnTerminal(L3GD20_Data_t* gyro_data, uint8_t motor_speed)
@@ -232,7 +382,7 @@ void LED_Init_All(void)
     // Tüm LED'leri kapat
     LED_Set_All(0);
     
-    HAL_UART_Transmit(&huart2, (uint8_t*)"🔥 8 LED Başlatıldı! 🔥\r\n", 28, HAL_MAX_DELAY);
+    SendDebugMessage("🔥 8 LED Başlatıldı! 🔥\r\n");
 }
 
 /**
@@ -0,0 +1,287 @@
+#include "motion_event.h"
+#include "motor.h"
+#include "motor_profile.h"
+#include "motor_queue.h"
+#include "motor_wave.h"
+#include "motor_stop.h"
+#include "motor_ident.h"
+#include "current_sense.h"
+#include "pid.h"
+#include "pid_tune.h"
+#include <math.h>
+#include <stdio.h>
+
+uint32_t motion_event_counts[MOTION_EVENT_COUNT];
+
+// Olay -> motor davranışı tablosu
+static const MotorAction_t motion_event_actions[MOTION_EVENT_COUNT] = {
+    [MOTION_EVENT_NONE]     = { MOTOR_ACTION_NONE,    0,    0,   0, 0 },
+    [MOTION_EVENT_SHAKE]    = { MOTOR_ACTION_PULSE,  80,  200, 200, 3 },
+    [MOTION_EVENT_TAP]      = { MOTOR_ACTION_PULSE, 100,  100,   0, 1 },
+    [MOTION_EVENT_ROTATION] = { MOTOR_ACTION_RAMP,   60, 1000,   0, 0 },
+    [MOTION_EVENT_REST]     = { MOTOR_ACTION_STOP,    0,    0,   0, 0 },
+};
+
+static const char* const motion_event_names[MOTION_EVENT_COUNT] = {
+    "NONE", "SHAKE", "TAP", "ROTATION", "REST"
+};
+
+typedef enum {
+    TAP_IDLE = 0,
+    TAP_SPIKE,
+    TAP_SETTLE
+} TapState_t;
+
+typedef struct {
+    // SHAKE - eksen başına son yön (+1/-1/0) ve son N geçişin zamanı
+    int8_t shake_sign[3];
+    uint32_t shake_times[EVT_SHAKE_CROSSINGS];
+    uint8_t shake_head;
+    uint8_t shake_filled;
+    // TAP
+    TapState_t tap_state;
+    float tap_last_acc[3];
+    float tap_peak;
+    uint32_t tap_start_ms;
+    uint8_t tap_has_last;
+    // ROTATION / REST
+    uint8_t rotating;
+    uint8_t moving;             // Son REST'ten beri eşik üstü hareket görüldü
+    uint32_t rot_since_ms;      // Eşik üstüne çıkış anı (0 = altında)
+    uint32_t rest_since_ms;     // Eşik altına iniş anı (0 = üstünde)
+    uint32_t motion_start_ms;
+    // Refractory
+    uint32_t last_event_ms[MOTION_EVENT_COUNT];
+} MotionEventState_t;
+
+static MotionEventState_t evt;
+static uint8_t motor_enabled = 1;
+
+static void MotionEvent_StartAction(const MotorAction_t* action);
+
+/**
+ * @brief Durum makinelerini ve motor davranışını sıfırlar
+ */
+void MotionEvent_Init(void)
+{
+    memset(&evt, 0, sizeof(evt));
+    memset(motion_event_counts, 0, sizeof(motion_event_counts));
+}
+
+const char* MotionEvent_Name(MotionEvent_Type_t type)
+{
+    return (type < MOTION_EVENT_COUNT) ? motion_event_names[type] : "?";
+}
+
+/**
+ * @brief Olayları motor davranışına bağlar/ayırır (EVT komutu)
+ */
+void MotionEvent_SetMotorEnabled(uint8_t enabled)
+{
+    motor_enabled = enabled;
+    if (!enabled && MotorProfile_IsActive(MOTOR_MAIN))
+    {
+        MotorProfile_Cancel(MOTOR_MAIN);
+    }
+}
+
+/**
+ * @brief Bir motor davranışı çalışıyorsa 1 - ana döngü hız haritasını uygulamaz
+ */
+uint8_t MotionEvent_MotorActive(void)
+{
+    return MotorProfile_IsActive(MOTOR_MAIN);
+}
+
+static void MotionEvent_Emit(MotionEvent_Type_t type, float value, uint32_t now_ms)
+{
+    char msg[48];
+
+    if (evt.last_event_ms[type] != 0 && now_ms - evt.last_event_ms[type] < EVT_REFRACTORY_MS)
+    {
+        return;
+    }
+    evt.last_event_ms[type] = now_ms;
+    motion_event_counts[type]++;
+
+    sprintf(msg, "Event[%s t:%lu v:%.1f]\r\n", motion_event_names[type], now_ms, value);
+    SendDebugMessage(msg);
+
+    if (motor_enabled)
+    {
+        MotionEvent_StartAction(&motion_event_actions[type]);
+    }
+}
+
+static void MotionEvent_Shake(const float rate[3], uint32_t now_ms)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        int8_t sign = 0;
+        if (rate[i] > EVT_SHAKE_THRESH_DPS) sign = 1;
+        else if (rate[i] < -EVT_SHAKE_THRESH_DPS) sign = -1;
+
+        if (sign == 0 || sign == evt.shake_sign[i]) continue;
+
+        // Eşik-üstü ters yöne geçiş = bir yön değişimi
+        if (evt.shake_sign[i] != 0)
+        {
+            evt.shake_times[evt.shake_head] = now_ms;
+            evt.shake_head = (evt.shake_head + 1) % EVT_SHAKE_CROSSINGS;
+            if (evt.shake_filled < EVT_SHAKE_CROSSINGS) evt.shake_filled++;
+
+            // En eski kayıt pencere içindeyse N geçiş tamam
+            if (evt.shake_filled == EVT_SHAKE_CROSSINGS &&
+                now_ms - evt.shake_times[evt.shake_head] <= EVT_SHAKE_WINDOW_MS)
+            {
+                MotionEvent_Emit(MOTION_EVENT_SHAKE, (float)EVT_SHAKE_CROSSINGS, now_ms);
+                evt.shake_filled = 0;
+            }
+        }
+        evt.shake_sign[i] = sign;
+    }
+}
+
+static void MotionEvent_Tap(const float acc[3], uint32_t now_ms)
+{
+    float jerk = 0.0f;
+
+    if (evt.tap_has_last)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            float d = fabsf(acc[i] - evt.tap_last_acc[i]);
+            if (d > jerk) jerk = d;
+        }
+    }
+    evt.tap_last_acc[0] = acc[0];
+    evt.tap_last_acc[1] = acc[1];
+    evt.tap_last_acc[2] = acc[2];
+    evt.tap_has_last = 1;
+
+    switch (evt.tap_state)
+    {
+    case TAP_IDLE:
+        if (jerk > EVT_TAP_JERK_G)
+        {
+            evt.tap_state = TAP_SPIKE;
+            evt.tap_start_ms = now_ms;
+            evt.tap_peak = jerk;
+        }
+        break;
+
+    case TAP_SPIKE:
+        if (jerk > evt.tap_peak) evt.tap_peak = jerk;
+        if (now_ms - evt.tap_start_ms > EVT_TAP_MAX_MS)
+        {
+            evt.tap_state = TAP_SETTLE;   // Uzun sürdü - sarsıntı/taşıma, tap değil
+        }
+        else if (jerk < EVT_TAP_QUIET_G)
+        {
+            MotionEvent_Emit(MOTION_EVENT_TAP, evt.tap_peak, now_ms);
+            evt.tap_state = TAP_IDLE;
+        }
+        break;
+
+    case TAP_SETTLE:
+        if (jerk < EVT_TAP_QUIET_G) evt.tap_state = TAP_IDLE;
+        break;
+    }
+}
+
+static void MotionEvent_Rotation(float magnitude, uint32_t now_ms)
+{
+    // Sürekli dönüş
+    if (magnitude > EVT_ROT_THRESH_DPS)
+    {
+        if (!evt.moving)
+        {
+            evt.moving = 1;
+            evt.motion_start_ms = now_ms;
+        }
+        if (evt.rot_since_ms == 0) evt.rot_since_ms = now_ms;
+        if (!evt.rotating && now_ms - evt.rot_since_ms >= EVT_ROT_MIN_MS)
+        {
+            evt.rotating = 1;
+            MotionEvent_Emit(MOTION_EVENT_ROTATION, magnitude, now_ms);
+        }
+    }
+    else
+    {
+        evt.rot_since_ms = 0;
+    }
+
+    // Hareketsizliğe dönüş
+    if (magnitude < EVT_REST_THRESH_DPS)
+    {
+        if (evt.rest_since_ms == 0) evt.rest_since_ms = now_ms;
+        if (evt.moving && now_ms - evt.rest_since_ms >= EVT_REST_MIN_MS)
+        {
+            evt.moving = 0;
+            evt.rotating = 0;
+            MotionEvent_Emit(MOTION_EVENT_REST, (float)(now_ms - evt.motion_start_ms) / 1000.0f, now_ms);
+        }
+    }
+    else
+    {
+        evt.rest_since_ms = 0;
+    }
+}
+
+/**
+ * @brief Örnek başına çağrılır - olayları algılar
+ * @param gyro: Bias düzeltilmiş gyro verisi
+ * @param acc: İvme (g)
+ * @param now_ms: HAL_GetTick()
+ */
+void MotionEvent_Process(const L3GD20_Data_t* gyro, const float acc[3], uint32_t now_ms)
+{
+    float rate[3] = {gyro->x, gyro->y, gyro->z};
+
+    // 0 "henüz yok" anlamında kullanılıyor
+    if (now_ms == 0) now_ms = 1;
+
+    MotionEvent_Shake(rate, now_ms);
+    MotionEvent_Tap(acc, now_ms);
+    MotionEvent_Rotation(gyro->magnitude, now_ms);
+}
+
+/* ---- Motor davranışları - profil motoruna segment olarak verilir ---- */
+
+static void MotionEvent_StartAction(const MotorAction_t* action)
+{
+    MotorSegment_t seg[2];
+    uint8_t count = 0;
+
+    // Komutla başlatılan kuyruk/dalga olay tarafından kesilmez: titreşim dalgası
+    // aynı karttaki IMU'da SHAKE üretip kendini durdurabilirdi. Durma ölçümü
+    // ve diğer sahipler de (hız haritasıyla aynı koşullar) - frenin sarsıntısı
+    // TAP/SHAKE üretip ölçülen segmenti değiştirmesin
+    if (MotorQueue_Depth() > 0 || MotorWave_IsActive() || MotorStop_IsMeasuring() || Pid_IsEnabled() ||
+        CurrentSense_IsFaulted() || MotorIdent_IsRunning() || PidTune_IsRunning()) return;
+
+    switch (action->type)
+    {
+    case MOTOR_ACTION_PULSE:
+        seg[count++] = (MotorSegment_t){ .type = MOTOR_SEG_PULSE, .duty = (int8_t)action->speed,
+                                         .time_ms = action->on_ms, .off_ms = action->off_ms,
+                                         .count = action->count };
+        break;
+
+    case MOTOR_ACTION_RAMP:
+        // Rampa mevcut çıkıştan başlar, REST gelene kadar tutulur
+        seg[count++] = (MotorSegment_t){ .type = MOTOR_SEG_RAMP, .duty = (int8_t)action->speed,
+                                         .time_ms = action->on_ms };
+        seg[count++] = (MotorSegment_t){ .type = MOTOR_SEG_HOLD, .duty = (int8_t)action->speed };
+        break;
+
+    case MOTOR_ACTION_STOP:
+        MotorProfile_Cancel(MOTOR_MAIN);
+        return;
+
+    default:
+        return;
+    }
+
+    MotorProfile_Start(MOTOR_MAIN, seg, count);
+}
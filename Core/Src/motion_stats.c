@@ -0,0 +1,128 @@
+#include "motion_stats.h"
+#include <math.h>
+#include <stdio.h>
+#include <float.h>
+
+MotionStats_Window_t motion_stats[MOTION_STATS_WINDOWS];
+
+static const uint32_t motion_stats_default_ms[MOTION_STATS_WINDOWS] = {100, 1000, 10000};
+static uint32_t reported_seq[MOTION_STATS_WINDOWS];
+
+static void MotionStats_ResetAcc(MotionStats_Acc_t* acc)
+{
+    memset(acc, 0, sizeof(*acc));
+    for (int i = 0; i < 3; i++)
+    {
+        acc->min[i] = FLT_MAX;
+        acc->max[i] = -FLT_MAX;
+    }
+}
+
+/**
+ * @brief Varsayılan pencereler: 100ms, 1s, 10s
+ */
+void MotionStats_Init(void)
+{
+    for (int w = 0; w < MOTION_STATS_WINDOWS; w++)
+    {
+        MotionStats_SetWindow(w, motion_stats_default_ms[w]);
+    }
+}
+
+/**
+ * @brief Pencere uzunluğunu değiştirir ve pencereyi sıfırlar (STATW komutu)
+ */
+void MotionStats_SetWindow(uint8_t index, uint32_t length_ms)
+{
+    if (index >= MOTION_STATS_WINDOWS || length_ms == 0) return;
+
+    memset(&motion_stats[index], 0, sizeof(motion_stats[index]));
+    motion_stats[index].length_ms = length_ms;
+    motion_stats[index].start_ms = HAL_GetTick();
+    MotionStats_ResetAcc(&motion_stats[index].acc);
+    reported_seq[index] = 0;
+}
+
+static void MotionStats_Close(MotionStats_Window_t* win)
+{
+    MotionStats_Acc_t* acc = &win->acc;
+    MotionStats_Result_t* res = &win->last;
+
+    if (acc->n == 0) return;
+
+    float inv_n = 1.0f / (float)acc->n;
+    res->n = acc->n;
+    for (int i = 0; i < 3; i++)
+    {
+        res->mean[i] = acc->mean[i];
+        res->std[i] = sqrtf(acc->m2[i] * inv_n);
+        res->min[i] = acc->min[i];
+        res->max[i] = acc->max[i];
+        res->rms[i] = sqrtf(acc->sum_sq[i] * inv_n);
+    }
+    res->peak_mag = acc->peak_mag;
+    res->seq++;
+
+    MotionStats_ResetAcc(acc);
+}
+
+/**
+ * @brief Örnek başına çağrılır - tüm pencereleri O(1) günceller
+ */
+void MotionStats_Update(const L3GD20_Data_t* data, uint32_t now_ms)
+{
+    float v[3] = {data->x, data->y, data->z};
+
+    for (int w = 0; w < MOTION_STATS_WINDOWS; w++)
+    {
+        MotionStats_Window_t* win = &motion_stats[w];
+        MotionStats_Acc_t* acc = &win->acc;
+
+        if (now_ms - win->start_ms >= win->length_ms)
+        {
+            MotionStats_Close(win);
+            win->start_ms = now_ms;
+        }
+
+        acc->n++;
+        float inv_n = 1.0f / (float)acc->n;
+        for (int i = 0; i < 3; i++)
+        {
+            // Welford
+            float d = v[i] - acc->mean[i];
+            acc->mean[i] += d * inv_n;
+            acc->m2[i] += d * (v[i] - acc->mean[i]);
+
+            if (v[i] < acc->min[i]) acc->min[i] = v[i];
+            if (v[i] > acc->max[i]) acc->max[i] = v[i];
+            acc->sum_sq[i] += v[i] * v[i];
+        }
+        if (data->magnitude > acc->peak_mag) acc->peak_mag = data->magnitude;
+    }
+}
+
+/**
+ * @brief Son raporlamadan beri kapanan pencereleri UART'a yazar
+ */
+void MotionStats_Report(void)
+{
+    char msg[224];
+
+    for (int w = 0; w < MOTION_STATS_WINDOWS; w++)
+    {
+        MotionStats_Result_t* r = &motion_stats[w].last;
+
+        if (r->seq == reported_seq[w]) continue;
+        reported_seq[w] = r->seq;
+
+        sprintf(msg, "Stats[W:%lu N:%lu M:%.2f,%.2f,%.2f S:%.2f,%.2f,%.2f "
+                     "Min:%.1f,%.1f,%.1f Max:%.1f,%.1f,%.1f R:%.2f,%.2f,%.2f P:%.1f]\r\n",
+                motion_stats[w].length_ms, r->n,
+                r->mean[0], r->mean[1], r->mean[2],
+                r->std[0], r->std[1], r->std[2],
+                r->min[0], r->min[1], r->min[2],
+                r->max[0], r->max[1], r->max[2],
+                r->rms[0], r->rms[1], r->rms[2], r->peak_mag);
+        SendDebugMessage(msg);
+    }
+}
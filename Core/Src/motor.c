@@ -1,9 +1,12 @@
 #include "motor.h"
 #include "tim.h"
 #include "usart.h"
+#include "motor_profile.h"
+#include "motor_wave.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
 
 extern volatile uint8_t motorSpeed;  // From main.h
 extern char debugMsg[UART_BUFFER_SIZE];  // From main.h
@@ -16,11 +19,9 @@ void SetPWMDuty(uint8_t duty)
 {
     if (duty > 100) duty = 100;
     
-    // PWM duty cycle hesaplama (0-1000 arası)
-    uint32_t pulse = (duty * htim3.Init.Period) / 100;
-    
-    // PWM değerini ayarla
-    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse);
+    // PWM değerini ayarla - ileri yön (INA)
+    HW153_WriteDuty(duty, MOTOR_DIRECTION_FORWARD);
+    uint32_t pulse = (uint32_t)HW153_GetPulse();
     
     // Debug mesajı
     sprintf(debugMsg, "PWM Duty: %d%% (Pulse: %lu)\r\n", duty, pulse);
@@ -31,160 +32,286 @@ void SetMotorSpeed(uint8_t speed)
 {
     if (speed > 100) speed = 100;  // Limit speed to 100%
     
-    // Update global variable
-    motorSpeed = speed;
-    
     // Update PWM duty cycle
-    uint32_t pulse = (speed * htim3.Init.Period) / 100;
-    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse);
+    HW153_WriteDuty(speed, MOTOR_DIRECTION_FORWARD);
+    uint32_t pulse = (uint32_t)HW153_GetPulse();
     
     // Debug bilgisi
     sprintf(debugMsg, "HW-153 Motor: PWM=%d (%d%%)\r\n", (int)pulse, speed);
     SendDebugMessage(debugMsg);
 }
 
+static Motor_StopMode_t motor_stop_mode = MOTOR_STOP_COAST;   // HW153_SetMotor(0) / Motor_Stop
+static uint32_t pwm_requested_hz = 72000000UL / (TIM3_PRESCALER + 1) / (TIM3_PERIOD + 1);  // Rapor için
+
+/* HW-153 Motor Driver - ana motor kanalı (MOTOR_MAIN) üzerinden register yazımı
+ * (UART yok, ISR/tick içinden çağrılabilir)
+ * pulse: TIM3 compare değeri (0..ARR), negatif = geri yön
+ *
+ * HW-153 V1 Motor Driver Kontrol Tablosu:
+ * INA (PC6/CH1)  | INB (PC7/CH2) | Motor Durumu
+ * PWM            | LOW           | İleri yön (CW)
+ * LOW            | PWM           | Geri yön (CCW)
+ * HIGH/PWM       | HIGH/PWM      | Fren (HW153_WriteBrake)
+ * LOW            | LOW           | Serbest (Coast) */
+void HW153_WritePulse(int32_t pulse)
+{
+    MotorChannel_WritePulse(MOTOR_MAIN, pulse);
+}
+
+int32_t HW153_GetPulse(void)
+{
+    return MotorChannel_GetPulse(MOTOR_MAIN);
+}
+
+/* Aktif fren - INA ve INB aynı compare ile
+ * pulse: fren oranı (0..ARR), ARR ve üstü sürekli fren */
+void HW153_WriteBrake(int32_t pulse)
+{
+    MotorChannel_WriteBrake(MOTOR_MAIN, pulse);
+}
+
+uint8_t HW153_IsBraking(void)
+{
+    return MOTOR_MAIN->braking;
+}
+
+/* Açık durma: fren (tam) veya serbest */
+void HW153_Stop(Motor_StopMode_t mode)
+{
+    MotorChannel_Stop(MOTOR_MAIN, mode);
+}
+
+/* HW153_SetMotor(0) ve Motor_Stop'un kullandığı durma kipi */
+void Motor_SetStopMode(Motor_StopMode_t mode)
+{
+    motor_stop_mode = mode;
+}
+
+Motor_StopMode_t Motor_GetStopMode(void)
+{
+    return motor_stop_mode;
+}
+
+void HW153_WriteDuty(uint8_t speed, uint8_t direction)
+{
+    if (speed > 100) speed = 100;
+
+    int32_t duty = (int32_t)speed * (MOTOR_DUTY_FULL / 100);
+    HW153_WriteDutyFine((direction == MOTOR_DIRECTION_BACKWARD) ? -duty : duty);
+}
+
+/* Hassas duty: -MOTOR_DUTY_FULL..MOTOR_DUTY_FULL, işaret = yön
+ * Çözünürlük ARR'ye bağlı - ölçek periyottan bağımsızdır */
+void HW153_WriteDutyFine(int32_t duty)
+{
+    if (duty > MOTOR_DUTY_FULL) duty = MOTOR_DUTY_FULL;
+    else if (duty < -MOTOR_DUTY_FULL) duty = -MOTOR_DUTY_FULL;
+
+    MotorChannel_WriteDutyFine(MOTOR_MAIN, duty);
+}
+
+/* PWM frekansı (Hz) - TIM3 register'larından */
+uint32_t Motor_PwmFrequency(void)
+{
+    return SystemCoreClock / (TIM3->PSC + 1) / (TIM3->ARR + 1);
+}
+
+/**
+ * @brief TIM3 ve TIM4 PWM frekansını ve çözünürlüğünü çalışırken değiştirir
+ * Profiller PWM periyodu cinsinden koştuğu için tüm motor kanalları aynı periyotta tutulur.
+ * @param freq_hz: istenen PWM frekansı
+ * @param steps: periyot başına compare adımı (ARR+1), 0 = en yüksek çözünürlük
+ * @retval HAL_BUSY: profil/dalga çalışıyor (süreler ve compare değerleri eski ayara göre),
+ *         HAL_ERROR: frekans/çözünürlük timer ile elde edilemiyor
+ */
+HAL_StatusTypeDef Motor_ConfigurePwm(uint32_t freq_hz, uint32_t steps)
+{
+    uint32_t clk = SystemCoreClock;     // APB1 /2 -> timer x2 = 72MHz
+    uint32_t psc1, arr1;
+
+    if (freq_hz == 0 || freq_hz > clk / MOTOR_PWM_MIN_STEPS) return HAL_ERROR;
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        if (MotorProfile_IsActive(&motor_channels[i])) return HAL_BUSY;
+    }
+    if (MotorWave_IsActive()) return HAL_BUSY;
+
+    if (steps == 0)
+    {
+        // ARR'yi MOTOR_PWM_MAX_STEPS'e sığdıran en küçük bölücü
+        uint32_t counts = (clk + freq_hz / 2) / freq_hz;
+        psc1 = (counts + MOTOR_PWM_MAX_STEPS - 1) / MOTOR_PWM_MAX_STEPS;
+        arr1 = (counts + psc1 / 2) / psc1;
+    }
+    else
+    {
+        if (steps < MOTOR_PWM_MIN_STEPS || steps > MOTOR_PWM_MAX_STEPS) return HAL_ERROR;
+        uint64_t per_step = (uint64_t)freq_hz * steps;
+        psc1 = (uint32_t)((clk + per_step / 2) / per_step);
+        if (psc1 == 0 || psc1 > 65536) return HAL_ERROR;
+        arr1 = steps;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // Duty oranı korunur: compare yeni periyoda ölçeklenir (fren serbest bırakılır)
+    int32_t old_arr = (int32_t)__HAL_TIM_GET_AUTORELOAD(&htim3);
+    int32_t pulses[MOTOR_CHANNEL_COUNT];
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        pulses[i] = (int32_t)((int64_t)motor_channels[i].pulse * (int32_t)(arr1 - 1) / old_arr);
+    }
+
+    TIM_HandleTypeDef* timers[] = { &htim3, &htim4 };
+    for (uint8_t t = 0; t < 2; t++)
+    {
+        __HAL_TIM_SET_PRESCALER(timers[t], psc1 - 1);
+        __HAL_TIM_SET_AUTORELOAD(timers[t], arr1 - 1);
+        timers[t]->Init.Prescaler = psc1 - 1;
+        timers[t]->Init.Period = arr1 - 1;
+    }
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        MotorChannel_UpdateScale(&motor_channels[i]);
+        MotorChannel_WritePulse(&motor_channels[i], pulses[i]);
+    }
+
+    // Preload'ları hemen yükle; URS ile update kesmesi/DMA tetiklenmez
+    for (uint8_t t = 0; t < 2; t++)
+    {
+        timers[t]->Instance->CR1 |= TIM_CR1_URS;
+        timers[t]->Instance->EGR = TIM_EGR_UG;
+        timers[t]->Instance->CR1 &= ~TIM_CR1_URS;
+    }
+
+    __set_PRIMASK(primask);
+
+    pwm_requested_hz = freq_hz;
+    return HAL_OK;
+}
+
+void Motor_PwmReport(void)
+{
+    char msg[128];
+    uint32_t psc = TIM3->PSC;
+    uint32_t steps = TIM3->ARR + 1;
+    float freq = (float)SystemCoreClock / (float)((psc + 1) * steps);
+
+    sprintf(msg, "PWM[F:%.1fHz Hedef:%luHz Per:%.2fus PSC:%lu ARR:%lu Cozunurluk:%lu adim/%.1fbit]\r\n",
+            freq, pwm_requested_hz, 1e6f / freq, psc, steps - 1, steps, log2f((float)steps));
+    SendDebugMessage(msg);
+}
+
 /* HW-153 Motor Driver - Yön ve Hız Kontrolü */
 void HW153_SetMotor(uint8_t speed, uint8_t direction)
 {
+    static uint8_t last_speed = 0xFF;
+    static uint8_t last_direction = 0xFF;
+
     if (speed > 100) speed = 100;
-    
-    // HW-153 V1 Motor Driver Kontrol Tablosu:
-    // INA (PA6/PWM)  | INB (PA7)  | Motor Durumu
-    // PWM            | LOW        | İleri yön (CW)
-    // LOW            | PWM        | Geri yön (CCW)  
-    // PWM            | PWM        | Fren
-    // LOW            | LOW        | Serbest (Coast)
-    
+
+    if (speed == 0) HW153_Stop(motor_stop_mode);
+    else HW153_WriteDuty(speed, direction);
+
+    // Sadece durum değişince yaz - UART'ı her çağrıda bloklamasın
+    if (speed == last_speed && (direction == last_direction || speed == 0)) return;
+    last_speed = speed;
+    last_direction = direction;
+
     if (speed == 0) {
-        // Motor durdur - Serbest bırak (Coast)
-        __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, 0);  // PA6 = LOW
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_RESET);  // PA7 = LOW
-        sprintf(debugMsg, "HW-153: Motor DURDURULDU\r\n");
+        sprintf(debugMsg, "HW-153: Motor DURDURULDU (%s)\r\n", motor_stop_mode == MOTOR_STOP_BRAKE ? "fren" : "serbest");
     }
     else if (direction == MOTOR_DIRECTION_FORWARD) {
-        // İleri yön: INA=PWM, INB=LOW
-        uint32_t pulse = (speed * htim3.Init.Period) / 100;
-        __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse);  // PA6 = PWM
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_RESET);  // PA7 = LOW
         sprintf(debugMsg, "HW-153: İLERİ Yön, Hız: %d%%\r\n", speed);
     }
-    else if (direction == MOTOR_DIRECTION_BACKWARD) {
-        // Geri yön: INA=LOW, INB=HIGH (PWM yerine digital high kullanıyoruz)
-        __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, 0);  // PA6 = LOW
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_SET);   // PA7 = HIGH
+    else {
         sprintf(debugMsg, "HW-153: GERİ Yön, Hız: %d%%\r\n", speed);
     }
     
     SendDebugMessage(debugMsg);
 }
 
-void ProcessCommand(void)
-{
-    // "Dxx" formatında komut (xx = hız yüzdesi)
-    if (rxBuffer[0] == 'D')
-    {
-        int speed = atoi((char*)&rxBuffer[1]);
-        if (speed >= 0 && speed <= 100)
-        {
-            SetPWMDuty(speed);
-            sprintf(debugMsg, "Motor speed set to %d%%\r\n", speed);
-            SendDebugMessage(debugMsg);
-        }
-    }
-    
-    // UART'ı yeni komut için hazırla
-    HAL_UART_Receive_IT(&huart2, rxBuffer, 1);
-}
-
 void Motor_Init(void)
 {
     // Timer ve PWM zaten main.c'de başlatılıyor
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        MotorChannel_UpdateScale(&motor_channels[i]);
+    }
     // İlk başta motoru durdur
     SetMotorSpeed(0);
     SendDebugMessage("Motor: Initialized and stopped\r\n");
 }
 
-/* Motor Test Fonksiyonu */
+/* Motor Test Fonksiyonu - 0%'dan 100%'e 10'ar adım, her adım 2 sn
+ * Adımlar DMA dalga akışına sıralanır; çağrı hemen döner */
 void Motor_Test(void)
 {
     SendDebugMessage("\r\n=== MOTOR PWM TEST BAŞLADI ===\r\n");
     
-    // TIM3 PWM başlatma kontrolü
-    if (HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1) != HAL_OK) {
-        SendDebugMessage("HATA: PWM başlatılamadı!\r\n");
-        return;
-    }
-    
     // 0%'dan 100%'e kadar test
     for (uint8_t duty = 0; duty <= 100; duty += 10) {
-        sprintf(debugMsg, "PWM Test: %d%% duty cycle\r\n", duty);
-        SendDebugMessage(debugMsg);
-        
-        // PWM değerini hesapla ve ayarla
-        uint32_t pulse_value = (duty * htim3.Init.Period) / 100;
-        __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pulse_value);
-        
-        sprintf(debugMsg, "Period: %lu, Pulse: %lu, Duty: %d%%\r\n", 
-                htim3.Init.Period, pulse_value, duty);
-        SendDebugMessage(debugMsg);
-        
-        HAL_Delay(2000); // Her adımda 2 saniye bekle
+        if (MotorWave_Queue((int32_t)duty * (MOTOR_DUTY_FULL / 100), 2000, 0, 1) != HAL_OK) {
+            SendDebugMessage("HATA: Dalga kuyruğu dolu!\r\n");
+            break;
+        }
+    }
+    
+    if (MotorWave_Stream() != HAL_OK) {
+        SendDebugMessage("HATA: PWM dalga akışı başlatılamadı!\r\n");
+        return;
     }
     
-    // Motoru durdur
-    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, 0);
-    SendDebugMessage("=== MOTOR PWM TEST BİTTİ ===\r\n");
+    sprintf(debugMsg, "Period: %lu, %lu Hz, 11 adım x 2000ms (WST ile izlenir)\r\n",
+            __HAL_TIM_GET_AUTORELOAD(&htim3), Motor_PwmFrequency());
+    SendDebugMessage(debugMsg);
 }
 
-/* PA6 ve PA7 Pin Test - HW-153 için GPIO kontrolü */
+/* PC6 ve PC7 Pin Test - HW-153 için GPIO kontrolü */
 void Motor_PinTest(void)
 {
-    SendDebugMessage("\r\n=== HW-153 PA6 & PA7 PIN TEST ===\r\n");
+    SendDebugMessage("\r\n=== HW-153 PC6 & PC7 PIN TEST ===\r\n");
     
-    // PA6 ve PA7'yi GPIO output yap
+    // PC6 ve PC7'yi GPIO output yap
     GPIO_InitTypeDef GPIO_InitStruct = {0};
-    GPIO_InitStruct.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+    GPIO_InitStruct.Pin = MOTOR_INA_PIN | MOTOR_INB_PIN;
     GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
     
     // Her iki pini test et
     for(int i = 0; i < 5; i++) {
-        // PA6 HIGH, PA7 LOW
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_6, GPIO_PIN_SET);
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_RESET);
-        SendDebugMessage("PA6=HIGH, PA7=LOW\r\n");
+        // PC6 HIGH, PC7 LOW
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INA_PIN, GPIO_PIN_SET);
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INB_PIN, GPIO_PIN_RESET);
+        SendDebugMessage("PC6=HIGH, PC7=LOW\r\n");
         HAL_Delay(1000);
         
-        // PA6 LOW, PA7 HIGH  
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_6, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_SET);
-        SendDebugMessage("PA6=LOW, PA7=HIGH\r\n");
+        // PC6 LOW, PC7 HIGH  
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INA_PIN, GPIO_PIN_RESET);
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INB_PIN, GPIO_PIN_SET);
+        SendDebugMessage("PC6=LOW, PC7=HIGH\r\n");
         HAL_Delay(1000);
         
         // Her ikisi LOW
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_6, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_RESET);
-        SendDebugMessage("PA6=LOW, PA7=LOW\r\n");
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INA_PIN, GPIO_PIN_RESET);
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INB_PIN, GPIO_PIN_RESET);
+        SendDebugMessage("PC6=LOW, PC7=LOW\r\n");
         HAL_Delay(1000);
         
         // Her ikisi HIGH
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_6, GPIO_PIN_SET);
-        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_7, GPIO_PIN_SET);
-        SendDebugMessage("PA6=HIGH, PA7=HIGH\r\n");
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INA_PIN, GPIO_PIN_SET);
+        HAL_GPIO_WritePin(GPIOC, MOTOR_INB_PIN, GPIO_PIN_SET);
+        SendDebugMessage("PC6=HIGH, PC7=HIGH\r\n");
         HAL_Delay(1000);
     }
     
-    // PA6'yı PWM, PA7'yi GPIO output yap (normal HW-153 config)
-    GPIO_InitStruct.Pin = GPIO_PIN_6;
-    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
-    GPIO_InitStruct.Alternate = GPIO_AF2_TIM3;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
-    
-    GPIO_InitStruct.Pin = GPIO_PIN_7;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    // PC6/PC7'yi tekrar TIM3 PWM yap (normal HW-153 config)
+    HAL_TIM_MspPostInit(&htim3);
+    HW153_WritePulse(0);
     
     SendDebugMessage("=== HW-153 PIN TEST BİTTİ ===\r\n");
 }
@@ -249,30 +376,31 @@ void Motor_SimpleTest(void)
     sprintf(debugMsg, "TIM3 ARR: %lu, PSC: %lu\r\n", TIM3->ARR, TIM3->PSC);
     SendDebugMessage(debugMsg);
     
-    sprintf(debugMsg, "TIM3 CCR1: %lu, CCMR1: 0x%08lX\r\n", TIM3->CCR1, TIM3->CCMR1);
+    sprintf(debugMsg, "TIM3 CCR1: %lu, CCR2: %lu, CCMR1: 0x%08lX\r\n", TIM3->CCR1, TIM3->CCR2, TIM3->CCMR1);
     SendDebugMessage(debugMsg);
     
-    // PWM'i tekrar başlat
-    HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+    // PWM'i tekrar başlat - sadece INA, INB LOW
+    HAL_TIM_PWM_Start(&htim3, MOTOR_INA_CHANNEL);
+    TIM3->CCR2 = 0;
     
     SendDebugMessage("Test 1: 25% PWM - 3 saniye\r\n");
-    TIM3->CCR1 = 250;  // 25%
+    HW153_WriteDutyFine(MOTOR_DUTY_FULL / 4);       // 25%
     HAL_Delay(3000);
     
     SendDebugMessage("Test 2: 50% PWM - 3 saniye\r\n");
-    TIM3->CCR1 = 500;  // 50%
+    HW153_WriteDutyFine(MOTOR_DUTY_FULL / 2);       // 50%
     HAL_Delay(3000);
     
     SendDebugMessage("Test 3: 75% PWM - 3 saniye\r\n");
-    TIM3->CCR1 = 750;  // 75%
+    HW153_WriteDutyFine(MOTOR_DUTY_FULL * 3 / 4);   // 75%
     HAL_Delay(3000);
     
     SendDebugMessage("Test 4: 100% PWM - 3 saniye\r\n");
-    TIM3->CCR1 = 999;  // 100%
+    HW153_WriteDutyFine(MOTOR_DUTY_FULL);           // 100%
     HAL_Delay(3000);
     
     // PWM'i durdur
-    TIM3->CCR1 = 0;
+    HW153_WritePulse(0);
     SendDebugMessage("=== MOTOR TEST TAMAMLANDI ===\r\n");
     
     sprintf(debugMsg, "Final TIM3 CCR1: %lu\r\n", TIM3->CCR1);
@@ -316,46 +444,40 @@ void Motor_RotateContinuous(uint8_t speed)
 void Motor_Stop(void)
 {
     SendDebugMessage("Motor: Durduruldu\r\n");
-    SetMotorSpeed(0);
+    HW153_Stop(motor_stop_mode);
 }
 
+/* Rampa - profil motoruna devredilir, çağrı hemen döner */
 void Motor_SpeedRamp(uint8_t start_speed, uint8_t end_speed, uint32_t ramp_time_ms)
 {
+    MotorSegment_t ramp[2] = {
+        { .type = MOTOR_SEG_RAMP, .duty = (int8_t)(start_speed > 100 ? 100 : start_speed) },
+        { .type = MOTOR_SEG_RAMP, .duty = (int8_t)(end_speed > 100 ? 100 : end_speed),
+          .time_ms = (uint16_t)(ramp_time_ms > 0xFFFF ? 0xFFFF : ramp_time_ms) },
+    };
+
     sprintf(debugMsg, "Motor: Hız rampa - %d%% -> %d%%, Süre: %lums\r\n", 
             start_speed, end_speed, ramp_time_ms);
     SendDebugMessage(debugMsg);
-    
-    int32_t speed_diff = end_speed - start_speed;
-    uint32_t step_delay = ramp_time_ms / 100; // 100 adımda ramp
-    
-    for (int i = 0; i <= 100; i++)
+
+    if (MotorProfile_Start(MOTOR_MAIN, ramp, 2) != HAL_OK)
     {
-        uint8_t current_speed = start_speed + (speed_diff * i) / 100;
-        SetMotorSpeed(current_speed);
-        HAL_Delay(step_delay);
+        SendDebugMessage("Motor: Rampa başlatılamadı (PID aktif)\r\n");
     }
-    
-    sprintf(debugMsg, "Motor: Hız rampa tamamlandı - Son hız: %d%%\r\n", end_speed);
-    SendDebugMessage(debugMsg);
 }
 
+/* Darbe dizisi - DMA dalga akışıyla periyot hassasiyetinde, çağrı hemen döner */
 void Motor_Pulse(uint8_t speed, uint32_t on_time_ms, uint32_t off_time_ms, uint8_t pulse_count)
 {
     sprintf(debugMsg, "Motor: Pulse modu - Hız: %d%%, On: %lums, Off: %lums, Sayı: %d\r\n", 
             speed, on_time_ms, off_time_ms, pulse_count);
     SendDebugMessage(debugMsg);
-    
-    for (uint8_t i = 0; i < pulse_count; i++)
+
+    if (pulse_count == 0) return;
+    if (speed > 100) speed = 100;
+    if (MotorWave_Queue((int32_t)speed * (MOTOR_DUTY_FULL / 100), on_time_ms, off_time_ms, pulse_count) != HAL_OK ||
+        MotorWave_Stream() != HAL_OK)
     {
-        sprintf(debugMsg, "Pulse %d/%d\r\n", i+1, pulse_count);
-        SendDebugMessage(debugMsg);
-        
-        SetMotorSpeed(speed);      // Motor aç
-        HAL_Delay(on_time_ms);
-        
-        SetMotorSpeed(0);          // Motor kapat
-        HAL_Delay(off_time_ms);
+        SendDebugMessage("Motor: Pulse başlatılamadı (PID aktif / kuyruk dolu)\r\n");
     }
-    
-    SendDebugMessage("Motor: Pulse modu tamamlandı\r\n");
-} 
\ No newline at end of file
+}
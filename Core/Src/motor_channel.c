@@ -0,0 +1,248 @@
+#include "motor_channel.h"
+#include "motor.h"
+#include "tim.h"
+#include <stdio.h>
+
+MotorChannel_t motor_channels[MOTOR_CHANNEL_COUNT] = {
+    { .name = "M0", .htim = &htim3, .drive = MOTOR_DRIVE_DUAL_PWM,
+      .channel_a = MOTOR_INA_CHANNEL, .channel_b = MOTOR_INB_CHANNEL, .sense_channel = MOTOR_SENSE_CHANNEL,
+      .max_duty = MOTOR_DUTY_FULL },
+    { .name = "M1", .htim = &htim4, .drive = MOTOR_DRIVE_DUAL_PWM,
+      .channel_a = MOTOR1_INA_CHANNEL, .channel_b = MOTOR1_INB_CHANNEL, .sense_channel = MOTOR_CHANNEL_NONE,
+      .max_duty = MOTOR_DUTY_FULL },
+    { .name = "M2", .htim = &htim4, .drive = MOTOR_DRIVE_PWM_DIR,
+      .channel_a = MOTOR2_PWM_CHANNEL, .channel_b = MOTOR_CHANNEL_NONE, .sense_channel = MOTOR_CHANNEL_NONE,
+      .dir_port = MOTOR2_DIR_GPIO_Port, .dir_pin = MOTOR2_DIR_PIN, .max_duty = MOTOR_DUTY_FULL },
+    { .name = "M3", .htim = &htim4, .drive = MOTOR_DRIVE_PWM_DIR,
+      .channel_a = MOTOR3_PWM_CHANNEL, .channel_b = MOTOR_CHANNEL_NONE, .sense_channel = MOTOR_CHANNEL_NONE,
+      .dir_port = MOTOR3_DIR_GPIO_Port, .dir_pin = MOTOR3_DIR_PIN, .max_duty = MOTOR_DUTY_FULL },
+};
+
+/**
+ * @brief İndeksten kanal, geçersizse NULL
+ */
+MotorChannel_t* MotorChannel_Get(uint8_t index)
+{
+    return (index < MOTOR_CHANNEL_COUNT) ? &motor_channels[index] : NULL;
+}
+
+uint8_t MotorChannel_Index(const MotorChannel_t* ch)
+{
+    return (uint8_t)(ch - motor_channels);
+}
+
+int32_t MotorChannel_Period(const MotorChannel_t* ch)
+{
+    return (int32_t)__HAL_TIM_GET_AUTORELOAD(ch->htim);
+}
+
+/**
+ * @brief Compare sınırı ve duty ölçeğini ARR ve max_duty'den yeniden hesaplar
+ *        ARR veya sınır değiştiğinde, kesmeler kapalıyken çağrılır (bölme burada)
+ */
+void MotorChannel_UpdateScale(MotorChannel_t* ch)
+{
+    uint32_t arr = (uint32_t)MotorChannel_Period(ch);
+
+    ch->limit = (int32_t)((uint64_t)arr * ch->max_duty / MOTOR_DUTY_FULL);
+    ch->duty_scale = (uint32_t)((((uint64_t)arr << 16) + MOTOR_DUTY_FULL / 2) / MOTOR_DUTY_FULL);
+}
+
+static void MotorChannel_SetSense(MotorChannel_t* ch, uint32_t magnitude, int32_t arr)
+{
+    // Akım örneği iletim süresinin ortasında; motor dururken periyot ortasında (sıfır noktası)
+    if (ch->sense_channel == MOTOR_CHANNEL_NONE) return;
+    __HAL_TIM_SET_COMPARE(ch->htim, ch->sense_channel, magnitude ? (magnitude + 1) / 2 : (uint32_t)arr / 2);
+}
+
+/**
+ * @brief PWM_DIR yön değişimi - çıkış DIR çevrilmeden önce anında düşürülür
+ * CCR preload'u update'i beklediği için "CCR = 0" eski duty'yi periyot sonuna
+ * kadar yeni yönde sürdürürdü. OCxM = force inactive yazıldığı anda geçerli;
+ * yeni compare preload kapalıyken doğrudan yüklenip PWM1 geri açılır.
+ */
+static void MotorChannel_Reverse(MotorChannel_t* ch, GPIO_PinState dir, uint32_t magnitude)
+{
+    TIM_TypeDef* tim = ch->htim->Instance;
+    volatile uint32_t* ccmr = (ch->channel_a < TIM_CHANNEL_3) ? &tim->CCMR1 : &tim->CCMR2;
+    uint32_t shift = (ch->channel_a & 0x4U) ? 8U : 0U;
+    uint32_t mask = (TIM_CCMR1_OC1M | TIM_CCMR1_OC1PE) << shift;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *ccmr = (*ccmr & ~mask) | (TIM_OCMODE_FORCED_INACTIVE << shift);
+    HAL_GPIO_WritePin(ch->dir_port, ch->dir_pin, dir);
+    __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_a, magnitude);
+    *ccmr = (*ccmr & ~mask) | (TIM_OCMODE_PWM1 << shift);
+    *ccmr |= TIM_CCMR1_OC1PE << shift;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Compare yazımı - UART yok, ISR/tick içinden çağrılabilir
+ * @param pulse: 0..ARR, negatif = geri yön; kanal sınırına kırpılır
+ */
+void MotorChannel_WritePulse(MotorChannel_t* ch, int32_t pulse)
+{
+    int32_t arr = MotorChannel_Period(ch);
+    int32_t limit = ch->limit;
+
+    if (pulse > limit) pulse = limit;
+    else if (pulse < -limit) pulse = -limit;
+
+    ch->pulse = pulse;
+    ch->braking = 0;
+
+    int32_t out = ch->invert ? -pulse : pulse;
+    uint32_t magnitude = (uint32_t)((out < 0) ? -out : out);
+
+    if (ch->drive == MOTOR_DRIVE_PWM_DIR)
+    {
+        // Yön değişimi çıkış düşükken: eski duty yeni yönde sürmesin
+        GPIO_PinState dir = (out < 0) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+        if (HAL_GPIO_ReadPin(ch->dir_port, ch->dir_pin) != dir) MotorChannel_Reverse(ch, dir, magnitude);
+        else __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_a, magnitude);
+    }
+    else if (out >= 0)
+    {
+        // İleri yön (0 = Coast): INA=PWM, INB=LOW
+        __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_b, 0);
+        __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_a, magnitude);
+    }
+    else
+    {
+        // Geri yön: INA=LOW, INB=PWM
+        __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_a, 0);
+        __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_b, magnitude);
+    }
+
+    MotorChannel_SetSense(ch, magnitude, arr);
+}
+
+/**
+ * @brief Hassas duty -> compare (işaret = yön), sınır uygulanmamış
+ *        Q16 çarp-kaydır, büyüklük üzerinden (yönler simetrik yuvarlanır)
+ */
+static int32_t MotorChannel_DutyToPulse(const MotorChannel_t* ch, int32_t duty)
+{
+    if (duty > MOTOR_DUTY_FULL) duty = MOTOR_DUTY_FULL;
+    else if (duty < -MOTOR_DUTY_FULL) duty = -MOTOR_DUTY_FULL;
+
+    uint32_t magnitude = (uint32_t)((duty < 0) ? -duty : duty);
+    int32_t pulse = (int32_t)(((uint64_t)magnitude * ch->duty_scale + 0x8000U) >> 16);
+    return (duty < 0) ? -pulse : pulse;
+}
+
+/**
+ * @brief Hassas duty: -MOTOR_DUTY_FULL..MOTOR_DUTY_FULL, işaret = yön
+ */
+void MotorChannel_WriteDutyFine(MotorChannel_t* ch, int32_t duty)
+{
+    MotorChannel_WritePulse(ch, MotorChannel_DutyToPulse(ch, duty));
+}
+
+/**
+ * @brief DUAL_PWM compare çifti (A, B) - WritePulse ile aynı sınır ve polarite, yazmadan
+ *        DMA dalga tamponları için; bölme yok, ISR'den çağrılabilir
+ * @retval Komut pulse'ı (ch->pulse anlamında, işaret = komut yönü)
+ */
+int32_t MotorChannel_DutyToCompare(const MotorChannel_t* ch, int32_t duty, uint16_t pair[2])
+{
+    int32_t pulse = MotorChannel_DutyToPulse(ch, duty);
+
+    if (pulse > ch->limit) pulse = ch->limit;
+    else if (pulse < -ch->limit) pulse = -ch->limit;
+
+    int32_t out = ch->invert ? -pulse : pulse;
+    pair[0] = (out > 0) ? (uint16_t)out : 0;
+    pair[1] = (out < 0) ? (uint16_t)(-out) : 0;
+    return pulse;
+}
+
+/**
+ * @brief Aktif fren - A ve B aynı compare ile: ikisi HIGH iken sargı kısa devre
+ * pulse: fren oranı (0..ARR), ARR ve üstü sürekli fren. PWM_DIR kanalında serbest durur.
+ */
+void MotorChannel_WriteBrake(MotorChannel_t* ch, int32_t pulse)
+{
+    int32_t arr = MotorChannel_Period(ch);
+
+    if (ch->drive != MOTOR_DRIVE_DUAL_PWM)
+    {
+        MotorChannel_WritePulse(ch, 0);
+        return;
+    }
+
+    if (pulse < 0) pulse = -pulse;
+    if (pulse > arr) pulse = arr;
+
+    ch->pulse = 0;          // Sürüş yok - yön/hız tüketicileri durmuş görür
+    ch->braking = (pulse != 0);
+
+    // PWM1'de CCR = ARR+1 periyot boyunca HIGH tutar (ARR <= 65534, bkz. MOTOR_PWM_MAX_STEPS)
+    uint32_t compare = (pulse == arr) ? (uint32_t)arr + 1 : (uint32_t)pulse;
+    __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_a, compare);
+    __HAL_TIM_SET_COMPARE(ch->htim, ch->channel_b, compare);
+    MotorChannel_SetSense(ch, (uint32_t)pulse, arr);
+}
+
+/**
+ * @brief Açık durma: fren (tam) veya serbest
+ */
+void MotorChannel_Stop(MotorChannel_t* ch, Motor_StopMode_t mode)
+{
+    if (mode == MOTOR_STOP_BRAKE) MotorChannel_WriteBrake(ch, MotorChannel_Period(ch));
+    else MotorChannel_WritePulse(ch, 0);
+}
+
+int32_t MotorChannel_GetPulse(const MotorChannel_t* ch)
+{
+    return ch->pulse;
+}
+
+/**
+ * @brief Çıkış büyüklüğü (%) - bölme içerir, ISR dışında (gösterim) çağrılır
+ */
+uint8_t MotorChannel_GetPercent(const MotorChannel_t* ch)
+{
+    int32_t pulse = ch->pulse;
+    int32_t arr = MotorChannel_Period(ch);
+
+    if (pulse < 0) pulse = -pulse;
+    return (arr > 0) ? (uint8_t)((int64_t)pulse * 100 / arr) : 0;
+}
+
+/**
+ * @brief Kanal sınırı ve polaritesi - motor serbest bırakılıp yeni ayarla yazılır
+ */
+HAL_StatusTypeDef MotorChannel_SetLimits(MotorChannel_t* ch, uint16_t max_duty, uint8_t invert)
+{
+    if (max_duty == 0 || max_duty > MOTOR_DUTY_FULL) return HAL_ERROR;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    ch->max_duty = max_duty;
+    ch->invert = invert ? 1 : 0;
+    MotorChannel_UpdateScale(ch);
+    MotorChannel_WritePulse(ch, 0);
+    __set_PRIMASK(primask);
+    return HAL_OK;
+}
+
+void MotorChannel_Report(void)
+{
+    char msg[96];
+
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        const MotorChannel_t* ch = &motor_channels[i];
+        int32_t arr = MotorChannel_Period(ch);
+
+        sprintf(msg, "%s[%s %s %.1f%%%s Max:%.1f%% Inv:%u]\r\n", ch->name,
+                (ch->htim->Instance == TIM3) ? "TIM3" : "TIM4",
+                (ch->drive == MOTOR_DRIVE_DUAL_PWM) ? "DUAL" : "DIR",
+                (float)ch->pulse * 100.0f / (float)arr, ch->braking ? " BRAKE" : "",
+                (float)ch->max_duty * 100.0f / MOTOR_DUTY_FULL, ch->invert);
+        SendDebugMessage(msg);
+    }
+}
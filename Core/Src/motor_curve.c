@@ -0,0 +1,175 @@
+#include "motor_curve.h"
+#include "motor.h"
+#include "L3GD20.h"
+#include <math.h>
+#include <stdio.h>
+
+const uint16_t* volatile motor_curve = motor_curve_default;
+volatile uint8_t motor_curve_shift = MOTOR_CURVE_SHIFT;
+
+static uint16_t curve_ram[MOTOR_CURVE_SIZE];
+static MotorCurve_Type_t curve_type = MOTOR_CURVE_DEFAULT;
+static float curve_min_dps = 0.5f;
+static float curve_max_dps = 10.0f;
+static float curve_k = 0.0f;
+
+static const char* const curve_names[MOTOR_CURVE_TYPE_COUNT] = {
+    "LIN", "EXP", "S", "CUSTOM", "DEFAULT"
+};
+
+/**
+ * @brief Hücre ortasındaki büyüklük (dps) - gen_motor_curve.py ile aynı
+ */
+static float MotorCurve_CellDps(uint32_t index, uint8_t shift)
+{
+    return sqrtf(((float)index + 0.5f) * (float)(1UL << shift)) * L3GD20_DPS_PER_LSB;
+}
+
+/**
+ * @brief max_dps'i tabloya sığdıran en küçük kaydırma
+ * @retval 0: max_dps uint32 mag2 aralığının dışında
+ */
+static uint8_t MotorCurve_ShiftFor(float max_dps)
+{
+    float lsb = max_dps / L3GD20_DPS_PER_LSB;
+    double mag2 = (double)lsb * (double)lsb;
+
+    for (uint8_t shift = MOTOR_CURVE_SHIFT; shift <= MOTOR_CURVE_SHIFT_MAX; shift++)
+    {
+        if (mag2 <= (double)((uint64_t)MOTOR_CURVE_SIZE << shift)) return shift;
+    }
+    return 0;
+}
+
+static uint16_t MotorCurve_ToDuty(float fraction)
+{
+    if (fraction <= 0.0f) return 0;
+    if (fraction >= 1.0f) return MOTOR_DUTY_FULL;
+    return (uint16_t)lroundf(fraction * (float)MOTOR_DUTY_FULL);
+}
+
+void MotorCurve_Init(void)
+{
+    motor_curve = motor_curve_default;
+    motor_curve_shift = MOTOR_CURVE_SHIFT;
+    curve_type = MOTOR_CURVE_DEFAULT;
+}
+
+/**
+ * @brief Parametrik eğriyi RAM tablosuna hesaplar (ana döngü - kayan nokta burada)
+ * min_dps altı 0, max_dps üstü %100; arada t = (mag - min) / (max - min) şekillendirilir.
+ * @param k: EXPO eğrilik (0'a yakın = doğrusal), SCURVE diklik
+ * @retval HAL_ERROR: geçersiz parametre veya max_dps tablo erişiminin (~573 dps) üstünde
+ */
+HAL_StatusTypeDef MotorCurve_Build(MotorCurve_Type_t type, float min_dps, float max_dps, float k)
+{
+    if (type == MOTOR_CURVE_DEFAULT)
+    {
+        MotorCurve_Init();
+        return HAL_OK;
+    }
+    if (type > MOTOR_CURVE_SCURVE || min_dps < 0.0f || max_dps <= min_dps) return HAL_ERROR;
+    if (type != MOTOR_CURVE_LINEAR && k <= 0.0f) return HAL_ERROR;
+    uint8_t shift = MotorCurve_ShiftFor(max_dps);
+    if (shift == 0) return HAL_ERROR;
+
+    // S-eğrisini uçlarda 0 ve 1'e oturtmak için logistic normalize edilir
+    float s0 = 1.0f / (1.0f + expf(k * 0.5f));
+    float s1 = 1.0f / (1.0f + expf(-k * 0.5f));
+    float e1 = expf(k) - 1.0f;
+
+    for (uint32_t i = 0; i < MOTOR_CURVE_SIZE; i++)
+    {
+        float mag = MotorCurve_CellDps(i, shift);
+        float t;
+
+        if (mag < min_dps)
+        {
+            curve_ram[i] = 0;
+            continue;
+        }
+        t = (mag - min_dps) / (max_dps - min_dps);
+        if (t > 1.0f) t = 1.0f;
+
+        if (type == MOTOR_CURVE_EXPO) t = (expf(k * t) - 1.0f) / e1;
+        else if (type == MOTOR_CURVE_SCURVE) t = (1.0f / (1.0f + expf(-k * (t - 0.5f))) - s0) / (s1 - s0);
+
+        curve_ram[i] = MotorCurve_ToDuty(t);
+    }
+
+    curve_type = type;
+    curve_min_dps = min_dps;
+    curve_max_dps = max_dps;
+    curve_k = k;
+    motor_curve_shift = shift;
+    motor_curve = curve_ram;
+    return HAL_OK;
+}
+
+/**
+ * @brief Noktalar arası doğrusal özel eğri - ilk noktadan önce 0, sondan sonra son değer
+ * @retval HAL_ERROR: nokta yok/çok fazla, dps artan sırada değil veya son nokta tablo erişiminin üstünde
+ */
+HAL_StatusTypeDef MotorCurve_BuildCustom(const MotorCurve_Point_t* points, uint8_t count)
+{
+    if (count == 0 || count > MOTOR_CURVE_MAX_POINTS) return HAL_ERROR;
+    for (uint8_t p = 0; p < count; p++)
+    {
+        if (points[p].duty > MOTOR_DUTY_FULL) return HAL_ERROR;
+        if (p > 0 && points[p].dps <= points[p - 1].dps) return HAL_ERROR;
+    }
+    uint8_t shift = MotorCurve_ShiftFor(points[count - 1].dps);
+    if (shift == 0) return HAL_ERROR;
+
+    uint8_t seg = 0;
+    for (uint32_t i = 0; i < MOTOR_CURVE_SIZE; i++)
+    {
+        float mag = MotorCurve_CellDps(i, shift);
+
+        if (mag < points[0].dps)
+        {
+            curve_ram[i] = 0;
+            continue;
+        }
+        while (seg + 1 < count && mag >= points[seg + 1].dps) seg++;
+        if (seg + 1 >= count)
+        {
+            curve_ram[i] = points[count - 1].duty;
+            continue;
+        }
+
+        const MotorCurve_Point_t* a = &points[seg];
+        const MotorCurve_Point_t* b = &points[seg + 1];
+        float t = (mag - a->dps) / (b->dps - a->dps);
+        curve_ram[i] = (uint16_t)lroundf((float)a->duty + t * ((float)b->duty - (float)a->duty));
+    }
+
+    curve_type = MOTOR_CURVE_CUSTOM;
+    curve_min_dps = points[0].dps;
+    curve_max_dps = points[count - 1].dps;
+    curve_k = 0.0f;
+    motor_curve_shift = shift;
+    motor_curve = curve_ram;
+    return HAL_OK;
+}
+
+/**
+ * @brief Eğri tipi ve birkaç örnek noktadaki duty
+ */
+void MotorCurve_Report(void)
+{
+    static const float probe_dps[] = { 0.5f, 1.0f, 2.0f, 5.0f, 10.0f };
+    char msg[160];
+    int len;
+
+    len = sprintf(msg, "Curve[%s %.2f-%.2fdps k:%.2f >>%u |", curve_names[curve_type],
+                  curve_min_dps, curve_max_dps, curve_k, motor_curve_shift);
+    for (uint8_t i = 0; i < sizeof(probe_dps) / sizeof(probe_dps[0]); i++)
+    {
+        float lsb = probe_dps[i] / L3GD20_DPS_PER_LSB;
+        uint16_t duty = MotorCurve_Lookup((uint32_t)(lsb * lsb));
+        len += sprintf(msg + len, " %.1f:%.1f%%", probe_dps[i], (float)duty * 100.0f / MOTOR_DUTY_FULL);
+    }
+    sprintf(msg + len, "]\r\n");
+    SendDebugMessage(msg);
+}
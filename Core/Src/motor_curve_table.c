@@ -0,0 +1,70 @@
+/* gen_motor_curve.py ile üretildi - elle düzenlemeyin */
+#include "motor_curve.h"
+
+/* Varsayılan eğri: doğrusal, 0.50 dps -> 0%, 10.00 dps -> 100% */
+const uint16_t motor_curve_default[MOTOR_CURVE_SIZE] = {
+        0,     0,   133,   253,   358,   451,   536,   615,   689,   758,   824,   887,   947,  1005,  1061,  1115,
+     1167,  1217,  1266,  1314,  1361,  1406,  1451,  1494,  1537,  1579,  1619,  1660,  1699,  1738,  1776,  1813,
+     1850,  1886,  1922,  1957,  1992,  2026,  2060,  2093,  2126,  2159,  2191,  2223,  2254,  2285,  2316,  2346,
+     2377,  2406,  2436,  2465,  2494,  2522,  2551,  2579,  2607,  2634,  2662,  2689,  2716,  2742,  2769,  2795,
+     2821,  2847,  2873,  2898,  2923,  2949,  2973,  2998,  3023,  3047,  3071,  3095,  3119,  3143,  3167,  3190,
+     3213,  3237,  3260,  3283,  3305,  3328,  3350,  3373,  3395,  3417,  3439,  3461,  3483,  3504,  3526,  3547,
+     3568,  3589,  3611,  3631,  3652,  3673,  3694,  3714,  3735,  3755,  3775,  3795,  3815,  3835,  3855,  3875,
+     3895,  3914,  3934,  3953,  3973,  3992,  4011,  4030,  4049,  4068,  4087,  4106,  4125,  4143,  4162,  4180,
+     4199,  4217,  4235,  4254,  4272,  4290,  4308,  4326,  4344,  4361,  4379,  4397,  4414,  4432,  4449,  4467,
+     4484,  4502,  4519,  4536,  4553,  4570,  4587,  4604,  4621,  4638,  4655,  4671,  4688,  4705,  4721,  4738,
+     4754,  4771,  4787,  4803,  4820,  4836,  4852,  4868,  4884,  4900,  4916,  4932,  4948,  4964,  4980,  4996,
+     5011,  5027,  5043,  5058,  5074,  5089,  5105,  5120,  5135,  5151,  5166,  5181,  5196,  5212,  5227,  5242,
+     5257,  5272,  5287,  5302,  5317,  5331,  5346,  5361,  5376,  5390,  5405,  5420,  5434,  5449,  5463,  5478,
+     5492,  5507,  5521,  5536,  5550,  5564,  5578,  5593,  5607,  5621,  5635,  5649,  5663,  5677,  5691,  5705,
+     5719,  5733,  5747,  5761,  5774,  5788,  5802,  5816,  5829,  5843,  5857,  5870,  5884,  5897,  5911,  5924,
+     5938,  5951,  5965,  5978,  5991,  6005,  6018,  6031,  6044,  6058,  6071,  6084,  6097,  6110,  6123,  6136,
+     6149,  6162,  6175,  6188,  6201,  6214,  6227,  6240,  6253,  6265,  6278,  6291,  6304,  6316,  6329,  6342,
+     6354,  6367,  6380,  6392,  6405,  6417,  6430,  6442,  6455,  6467,  6479,  6492,  6504,  6517,  6529,  6541,
+     6554,  6566,  6578,  6590,  6602,  6615,  6627,  6639,  6651,  6663,  6675,  6687,  6699,  6711,  6723,  6735,
+     6747,  6759,  6771,  6783,  6795,  6807,  6818,  6830,  6842,  6854,  6866,  6877,  6889,  6901,  6913,  6924,
+     6936,  6947,  6959,  6971,  6982,  6994,  7005,  7017,  7028,  7040,  7051,  7063,  7074,  7086,  7097,  7108,
+     7120,  7131,  7143,  7154,  7165,  7176,  7188,  7199,  7210,  7221,  7233,  7244,  7255,  7266,  7277,  7288,
+     7299,  7311,  7322,  7333,  7344,  7355,  7366,  7377,  7388,  7399,  7410,  7421,  7432,  7442,  7453,  7464,
+     7475,  7486,  7497,  7508,  7518,  7529,  7540,  7551,  7562,  7572,  7583,  7594,  7604,  7615,  7626,  7636,
+     7647,  7658,  7668,  7679,  7689,  7700,  7711,  7721,  7732,  7742,  7753,  7763,  7774,  7784,  7794,  7805,
+     7815,  7826,  7836,  7846,  7857,  7867,  7878,  7888,  7898,  7909,  7919,  7929,  7939,  7950,  7960,  7970,
+     7980,  7991,  8001,  8011,  8021,  8031,  8041,  8051,  8062,  8072,  8082,  8092,  8102,  8112,  8122,  8132,
+     8142,  8152,  8162,  8172,  8182,  8192,  8202,  8212,  8222,  8232,  8242,  8252,  8262,  8271,  8281,  8291,
+     8301,  8311,  8321,  8331,  8340,  8350,  8360,  8370,  8379,  8389,  8399,  8409,  8418,  8428,  8438,  8447,
+     8457,  8467,  8476,  8486,  8496,  8505,  8515,  8525,  8534,  8544,  8553,  8563,  8572,  8582,  8591,  8601,
+     8611,  8620,  8630,  8639,  8648,  8658,  8667,  8677,  8686,  8696,  8705,  8715,  8724,  8733,  8743,  8752,
+     8761,  8771,  8780,  8789,  8799,  8808,  8817,  8827,  8836,  8845,  8854,  8864,  8873,  8882,  8891,  8901,
+     8910,  8919,  8928,  8937,  8947,  8956,  8965,  8974,  8983,  8992,  9001,  9011,  9020,  9029,  9038,  9047,
+     9056,  9065,  9074,  9083,  9092,  9101,  9110,  9119,  9128,  9137,  9146,  9155,  9164,  9173,  9182,  9191,
+     9200,  9209,  9218,  9227,  9236,  9245,  9253,  9262,  9271,  9280,  9289,  9298,  9307,  9315,  9324,  9333,
+     9342,  9351,  9359,  9368,  9377,  9386,  9395,  9403,  9412,  9421,  9430,  9438,  9447,  9456,  9464,  9473,
+     9482,  9490,  9499,  9508,  9516,  9525,  9534,  9542,  9551,  9560,  9568,  9577,  9585,  9594,  9603,  9611,
+     9620,  9628,  9637,  9645,  9654,  9662,  9671,  9679,  9688,  9696,  9705,  9713,  9722,  9730,  9739,  9747,
+     9756,  9764,  9773,  9781,  9789,  9798,  9806,  9815,  9823,  9831,  9840,  9848,  9857,  9865,  9873,  9882,
+     9890,  9898,  9907,  9915,  9923,  9932,  9940,  9948,  9957,  9965,  9973,  9981,  9990,  9998, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+    10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000, 10000,
+};
@@ -0,0 +1,307 @@
+#include "motor_ident.h"
+#include "control.h"
+#include "motor.h"
+#include "motor_profile.h"
+#include "motor_queue.h"
+#include "motor_wave.h"
+#include "motion_event.h"
+#include "current_sense.h"
+#include "uart_tx.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+MotorIdent_Config_t motor_ident_config;
+
+static int16_t capture_duty[MOTOR_IDENT_MAX_SAMPLES];
+static float capture_response[MOTOR_IDENT_MAX_SAMPLES];
+static volatile uint16_t capture_count = 0;
+
+static volatile MotorIdent_State_t state = MOTOR_IDENT_IDLE;
+static volatile uint8_t finished = 0;       // Task raporlasın
+static uint32_t tick = 0;
+static uint32_t pre_ticks = 0;
+static uint32_t total_ticks = 0;
+static uint32_t bit_ticks = 1;
+static uint16_t lfsr = 0x1FF;
+static float chirp_phase = 0.0f;
+static int32_t last_duty = INT32_MIN;
+
+static const char* const signal_names[MOTOR_IDENT_SIGNAL_COUNT] = { "STEP", "PRBS", "CHIRP" };
+static const char* const state_names[] = { "IDLE", "RUN", "DONE", "ABORT" };
+static const char* const source_names[PID_FB_COUNT] = { "RATE", "ANGLE", "EXT", "RPM" };
+
+/**
+ * @brief Varsayılan: Z ekseni gyro hızı, her tick kayıt
+ */
+void MotorIdent_Init(void)
+{
+    memset(&motor_ident_config, 0, sizeof(motor_ident_config));
+    motor_ident_config.source = PID_FB_GYRO_RATE;
+    motor_ident_config.axis = 2;
+    motor_ident_config.decim = 1;
+    state = MOTOR_IDENT_IDLE;
+    capture_count = 0;
+    finished = 0;
+}
+
+/**
+ * @brief Kaydedilen yanıt ve kayıt aralığı
+ * @retval HAL_BUSY: kayıt sürüyor, HAL_ERROR: geçersiz parametre
+ */
+HAL_StatusTypeDef MotorIdent_SetSource(Pid_Feedback_t source, uint8_t axis, uint16_t decim)
+{
+    if (source >= PID_FB_COUNT || axis > 2 || decim == 0) return HAL_ERROR;
+    if (state == MOTOR_IDENT_RUNNING) return HAL_BUSY;
+
+    motor_ident_config.source = source;
+    motor_ident_config.axis = axis;
+    motor_ident_config.decim = decim;
+    return HAL_OK;
+}
+
+/**
+ * @brief Uyarımı başlatır - önceki kayıt silinir
+ * @retval HAL_BUSY: PID aktif, aşırı akım hatası veya kayıt sürüyor
+ *         HAL_ERROR: geçersiz parametre veya kayıt tampona sığmıyor
+ */
+HAL_StatusTypeDef MotorIdent_Start(MotorIdent_Signal_t signal, int16_t offset, int16_t amplitude,
+                                   uint16_t pre_ms, uint16_t duration_ms, float param_a, float param_b)
+{
+    MotorIdent_Config_t* cfg = &motor_ident_config;
+    uint32_t ticks_per_ms = CONTROL_TICK_HZ / 1000;
+    float nyquist = (float)CONTROL_TICK_HZ / (2.0f * (float)cfg->decim);
+
+    if (signal >= MOTOR_IDENT_SIGNAL_COUNT || duration_ms == 0) return HAL_ERROR;
+    if (offset > MOTOR_DUTY_FULL || offset < -MOTOR_DUTY_FULL) return HAL_ERROR;
+    if (amplitude > MOTOR_DUTY_FULL || amplitude < -MOTOR_DUTY_FULL) return HAL_ERROR;
+    if ((uint32_t)(pre_ms + duration_ms) * ticks_per_ms / cfg->decim > MOTOR_IDENT_MAX_SAMPLES) return HAL_ERROR;
+    if (signal == MOTOR_IDENT_PRBS && param_a < 1.0f) return HAL_ERROR;
+    if (signal == MOTOR_IDENT_CHIRP &&
+        (param_a < 0.0f || param_b < 0.0f || param_a > nyquist || param_b > nyquist)) return HAL_ERROR;
+    if (Pid_IsEnabled() || CurrentSense_IsFaulted() || state == MOTOR_IDENT_RUNNING) return HAL_BUSY;
+
+    // Motor tek kaynaktan sürülmeli
+    MotionEvent_SetMotorEnabled(0);
+    MotorProfile_Cancel(MOTOR_MAIN);
+    MotorWave_Stop();
+    MotorQueue_Flush();
+
+    __disable_irq();
+    cfg->signal = signal;
+    cfg->offset = offset;
+    cfg->amplitude = amplitude;
+    cfg->pre_ms = pre_ms;
+    cfg->duration_ms = duration_ms;
+    cfg->param_a = param_a;
+    cfg->param_b = param_b;
+
+    tick = 0;
+    pre_ticks = (uint32_t)pre_ms * ticks_per_ms;
+    total_ticks = pre_ticks + (uint32_t)duration_ms * ticks_per_ms;
+    bit_ticks = (uint32_t)lroundf(param_a) * ticks_per_ms;
+    if (bit_ticks == 0) bit_ticks = 1;
+    lfsr = 0x1FF;
+    chirp_phase = 0.0f;
+    last_duty = INT32_MIN;
+    capture_count = 0;
+    finished = 0;
+    state = MOTOR_IDENT_RUNNING;
+    __enable_irq();
+    return HAL_OK;
+}
+
+/**
+ * @brief Kaydı keser, motoru durdurur - örnekler dump için kalır
+ */
+void MotorIdent_Stop(void)
+{
+    if (state != MOTOR_IDENT_RUNNING) return;
+
+    __disable_irq();
+    state = MOTOR_IDENT_ABORTED;
+    HW153_Stop(Motor_GetStopMode());
+    __enable_irq();
+}
+
+uint8_t MotorIdent_IsRunning(void)
+{
+    return state == MOTOR_IDENT_RUNNING;
+}
+
+/**
+ * @brief Bu tick'in duty'si - t uyarım başından beri geçen tick
+ */
+static int32_t MotorIdent_Excitation(uint32_t t)
+{
+    const MotorIdent_Config_t* cfg = &motor_ident_config;
+    float u;
+
+    switch (cfg->signal)
+    {
+    case MOTOR_IDENT_PRBS:
+        if (t != 0 && t % bit_ticks == 0)
+        {
+            uint16_t bit = (uint16_t)(((lfsr >> 8) ^ (lfsr >> 4)) & 1U);
+            lfsr = (uint16_t)(((lfsr << 1) | bit) & 0x1FF);
+        }
+        return cfg->offset + ((lfsr & 1U) ? cfg->amplitude : -cfg->amplitude);
+
+    case MOTOR_IDENT_CHIRP:
+    {
+        // Anlık frekans f0 + (f1 - f0)·t/T, faz integrali
+        float frac = (float)t / (float)(total_ticks - pre_ticks);
+        float f = cfg->param_a + (cfg->param_b - cfg->param_a) * frac;
+        u = (float)cfg->offset + (float)cfg->amplitude * sinf(chirp_phase);
+        chirp_phase += 2.0f * (float)M_PI * f * CONTROL_DT_S;
+        if (chirp_phase > 2.0f * (float)M_PI) chirp_phase -= 2.0f * (float)M_PI;
+        return (int32_t)lroundf(u);
+    }
+
+    default:
+        return cfg->offset + cfg->amplitude;
+    }
+}
+
+/**
+ * @brief Bir uyarım/kayıt adımı - kontrol tick'inden (Encoder_Tick sonrası)
+ */
+void MotorIdent_Tick(void)
+{
+    const MotorIdent_Config_t* cfg = &motor_ident_config;
+
+    if (state != MOTOR_IDENT_RUNNING) return;
+
+    // Başka kaynak motoru aldıysa kayıt geçersiz
+    if (MotorProfile_IsActive(MOTOR_MAIN) || MotorWave_IsActive() || MotorQueue_Depth() > 0 ||
+        Pid_IsEnabled() || CurrentSense_IsFaulted())
+    {
+        state = MOTOR_IDENT_ABORTED;
+        finished = 1;
+        return;
+    }
+
+    if (tick >= total_ticks)
+    {
+        HW153_Stop(Motor_GetStopMode());
+        state = MOTOR_IDENT_DONE;
+        finished = 1;
+        return;
+    }
+
+    int32_t duty = (tick < pre_ticks) ? cfg->offset : MotorIdent_Excitation(tick - pre_ticks);
+    if (duty > MOTOR_DUTY_FULL) duty = MOTOR_DUTY_FULL;
+    else if (duty < -MOTOR_DUTY_FULL) duty = -MOTOR_DUTY_FULL;
+
+    if (tick % cfg->decim == 0 && capture_count < MOTOR_IDENT_MAX_SAMPLES)
+    {
+        capture_response[capture_count] = Pid_ReadFeedback(cfg->source, cfg->axis);
+        capture_duty[capture_count] = (int16_t)duty;
+        capture_count++;
+    }
+
+    if (duty != last_duty)
+    {
+        HW153_WriteDutyFine(duty);
+        last_duty = duty;
+    }
+    tick++;
+}
+
+/**
+ * @brief Ana döngü - biten kaydı raporlar
+ */
+void MotorIdent_Task(void)
+{
+    if (!finished) return;
+    finished = 0;
+    MotorIdent_Report();
+}
+
+/* CRC-16/CCITT-FALSE, parça parça - ACFG blob'u ile aynı */
+static uint16_t MotorIdent_Crc16(uint16_t crc, const uint8_t* data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void MotorIdent_Send(uint16_t* crc, const uint8_t* data, uint16_t len)
+{
+    *crc = MotorIdent_Crc16(*crc, data, len);
+    UartTx_WriteBlocking(data, len);
+}
+
+/**
+ * @brief Kaydı USART2'den ikili gönderir (little endian):
+ *   "SID1" | signal | source | axis | state | rate_hz(u16) | count(u16) | pre_count(u16)
+ *   offset(i16) | amplitude(i16) | duty_full(u16) | param_a(float) | param_b(float)
+ *   count x { duty(i16) | yanıt(float) }
+ *   crc16 (CCITT-FALSE, önceki tüm byte'lar)
+ * @retval HAL_BUSY: kayıt sürüyor, HAL_ERROR: kayıt yok
+ */
+HAL_StatusTypeDef MotorIdent_Dump(void)
+{
+    const MotorIdent_Config_t* cfg = &motor_ident_config;
+    uint8_t buf[MOTOR_IDENT_HEADER];
+    uint16_t crc = 0xFFFF;
+    uint16_t count = capture_count;
+    uint16_t rate = (uint16_t)(CONTROL_TICK_HZ / cfg->decim);
+    uint16_t pre_count = (uint16_t)((pre_ticks + cfg->decim - 1) / cfg->decim);
+    uint16_t full = MOTOR_DUTY_FULL;
+
+    if (state == MOTOR_IDENT_RUNNING) return HAL_BUSY;
+    if (state == MOTOR_IDENT_IDLE || count == 0) return HAL_ERROR;
+
+    memcpy(&buf[0], MOTOR_IDENT_MAGIC, 4);
+    buf[4] = (uint8_t)cfg->signal;
+    buf[5] = (uint8_t)cfg->source;
+    buf[6] = cfg->axis;
+    buf[7] = (uint8_t)state;
+    memcpy(&buf[8], &rate, 2);
+    memcpy(&buf[10], &count, 2);
+    memcpy(&buf[12], &pre_count, 2);
+    memcpy(&buf[14], &cfg->offset, 2);
+    memcpy(&buf[16], &cfg->amplitude, 2);
+    memcpy(&buf[18], &full, 2);
+    memcpy(&buf[20], &cfg->param_a, 4);
+    memcpy(&buf[24], &cfg->param_b, 4);
+    MotorIdent_Send(&crc, buf, MOTOR_IDENT_HEADER);
+
+    // Örnekler 4'erli paketlenir - 6 byte/örnek
+    for (uint16_t i = 0; i < count; i += 4)
+    {
+        uint16_t len = 0;
+        for (uint16_t j = i; j < count && j < i + 4; j++)
+        {
+            memcpy(&buf[len], &capture_duty[j], 2);
+            memcpy(&buf[len + 2], &capture_response[j], 4);
+            len += 6;
+        }
+        MotorIdent_Send(&crc, buf, len);
+    }
+
+    memcpy(buf, &crc, 2);
+    UartTx_WriteBlocking(buf, 2);
+    return HAL_OK;
+}
+
+void MotorIdent_Report(void)
+{
+    char msg[160];
+    const MotorIdent_Config_t* cfg = &motor_ident_config;
+
+    sprintf(msg, "Ident[%s %s %s%c %luHz Off:%.2f%% Amp:%.2f%% Pre:%ums Dur:%ums A:%.2f B:%.2f | %u/%u]\r\n",
+            state_names[state], signal_names[cfg->signal],
+            source_names[cfg->source], 'X' + cfg->axis, (unsigned long)(CONTROL_TICK_HZ / cfg->decim),
+            (float)cfg->offset * 100.0f / MOTOR_DUTY_FULL, (float)cfg->amplitude * 100.0f / MOTOR_DUTY_FULL,
+            cfg->pre_ms, cfg->duration_ms, cfg->param_a, cfg->param_b,
+            capture_count, MOTOR_IDENT_MAX_SAMPLES);
+    SendDebugMessage(msg);
+}
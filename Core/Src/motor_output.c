@@ -0,0 +1,120 @@
+#include "motor_output.h"
+#include "motor.h"
+#include "tim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+MotorOutput_Config_t motor_output_config;
+MotorOutput_Stats_t motor_output_stats;
+
+static int32_t output = 0;          // Son istenen hassas duty, işaret = yön
+static uint8_t synced = 0;          // 0: başka kaynak sürdü, donanımdan devral
+static uint32_t last_report_ms = 0;
+static uint32_t last_report_writes = 0;
+
+/**
+ * @brief Varsayılanlar: %8 kalkış / %3 durma, %1 band, 10 ms'de %5 (0->100% 200 ms)
+ */
+void MotorOutput_Init(void)
+{
+    motor_output_config.deadband_on = 800;
+    motor_output_config.deadband_off = 300;
+    motor_output_config.hysteresis = 100;
+    motor_output_config.slew_per_tick = 500;
+
+    memset(&motor_output_stats, 0, sizeof(motor_output_stats));
+    output = 0;
+    synced = 0;
+    last_report_ms = HAL_GetTick();
+    last_report_writes = 0;
+}
+
+/**
+ * @brief Hedefi koşullandırıp motora uygular (örnekleme tick'inde)
+ * @param target: hassas duty, -MOTOR_DUTY_FULL..MOTOR_DUTY_FULL
+ */
+void MotorOutput_Update(int32_t target)
+{
+    const MotorOutput_Config_t* cfg = &motor_output_config;
+
+    motor_output_stats.updates++;
+
+    // Profil/dalga/PID sonrası donanımın bıraktığı noktadan devam et
+    if (!synced)
+    {
+        int32_t arr = (int32_t)__HAL_TIM_GET_AUTORELOAD(&htim3);
+        output = HW153_GetPulse() * MOTOR_DUTY_FULL / arr;
+        synced = 1;
+    }
+
+    if (target > MOTOR_DUTY_FULL) target = MOTOR_DUTY_FULL;
+    else if (target < -MOTOR_DUTY_FULL) target = -MOTOR_DUTY_FULL;
+
+    // 1. Ölü bölge histerezisi
+    int32_t magnitude = abs(target);
+    uint16_t threshold = (output == 0) ? cfg->deadband_on : cfg->deadband_off;
+    if (magnitude < threshold)
+    {
+        if (target != 0) motor_output_stats.deadband++;
+        target = 0;
+    }
+
+    // 2. Histerezis bandı - sıfıra iniş her zaman geçer
+    int32_t delta = target - output;
+    if (target != 0 && abs(delta) < cfg->hysteresis)
+    {
+        if (delta != 0) motor_output_stats.hysteresis++;
+        delta = 0;
+    }
+
+    // 3. Eğim sınırı
+    if (cfg->slew_per_tick != 0 && abs(delta) > cfg->slew_per_tick)
+    {
+        delta = (delta > 0) ? cfg->slew_per_tick : -(int32_t)cfg->slew_per_tick;
+        motor_output_stats.slew_limited++;
+    }
+
+    // 4. Sadece değişince yaz
+    if (delta == 0)
+    {
+        motor_output_stats.unchanged++;
+        return;
+    }
+    output += delta;
+    HW153_WriteDutyFine(output);
+    motor_output_stats.writes++;
+}
+
+/**
+ * @brief Motor başka kaynağa geçti - sonraki Update donanımdan devralır
+ */
+void MotorOutput_Release(void)
+{
+    synced = 0;
+}
+
+int32_t MotorOutput_Get(void)
+{
+    return output;
+}
+
+void MotorOutput_Report(void)
+{
+    char msg[160];
+    uint32_t now = HAL_GetTick();
+    uint32_t elapsed = now - last_report_ms;
+    uint32_t writes = motor_output_stats.writes;
+    float rate = elapsed ? (float)(writes - last_report_writes) * 1000.0f / (float)elapsed : 0.0f;
+
+    sprintf(msg, "Out[%.2f%% Upd:%lu Wr:%lu (%.1f/s) Same:%lu DB:%lu Hys:%lu Slew:%lu | DB:%u/%u Band:%u Slew:%u/tick]\r\n",
+            (float)output * 100.0f / MOTOR_DUTY_FULL, motor_output_stats.updates, writes, rate,
+            motor_output_stats.unchanged, motor_output_stats.deadband,
+            motor_output_stats.hysteresis, motor_output_stats.slew_limited,
+            motor_output_config.deadband_on, motor_output_config.deadband_off,
+            motor_output_config.hysteresis, motor_output_config.slew_per_tick);
+    SendDebugMessage(msg);
+
+    last_report_ms = now;
+    last_report_writes = writes;
+}
@@ -0,0 +1,330 @@
+#include "motor_profile.h"
+#include "motor.h"
+#include "motor_wave.h"
+#include "motor_queue.h"
+#include "pid.h"
+#include "tim.h"
+#include <stdio.h>
+#include <string.h>
+
+// Çıkış Q15 sabit noktada tutulur: 16 bit compare değeri int32'ye sığar
+#define PROFILE_Q   15
+
+// Başlatırken PWM periyodu cinsine derlenmiş segment
+typedef struct {
+    MotorSegment_Type_t type;
+    int32_t target;         // Compare değeri, işaret = yön
+    int32_t step_q;         // RAMP: tick başına artış (Q15)
+    uint32_t ticks;         // RAMP/HOLD süresi, PULSE açık süresi
+    uint32_t period;        // PULSE: açık + kapalı
+    uint8_t count;
+    uint8_t move;           // MOVE: move_plans indeksi
+} MotorProfile_Step_t;
+
+// Kanal başına profil durumu
+typedef struct {
+    MotorProfile_Step_t steps[MOTOR_PROFILE_MAX_SEGMENTS];
+    uint8_t step_count;
+    uint8_t step_index;
+    uint32_t step_tick;
+    uint8_t pulse_index;
+    int32_t pos_q;
+    int32_t last_written;
+    volatile uint8_t active;
+    SpeedProfile_Plan_t move_plans[MOTOR_PROFILE_MAX_MOVES];
+    SpeedProfile_State_t move_state;
+    uint32_t expected_ticks;    // MOTOR_PROFILE_OPEN_ENDED: süresiz HOLD var
+    uint32_t expected_ms;
+    MotorProfile_Stats_t stats;
+} MotorProfile_Instance_t;
+
+static MotorProfile_Instance_t profiles[MOTOR_CHANNEL_COUNT];
+
+static MotorProfile_Instance_t* MotorProfile_Of(const MotorChannel_t* ch)
+{
+    return &profiles[MotorChannel_Index(ch)];
+}
+
+static uint8_t MotorProfile_AnyActive(void)
+{
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        if (profiles[i].active) return 1;
+    }
+    return 0;
+}
+
+static uint32_t MotorProfile_MsToTicks(uint32_t ms, uint32_t pwm_hz)
+{
+    uint32_t ticks = (uint32_t)(((uint64_t)ms * pwm_hz + 500) / 1000);
+    return (ticks == 0 && ms != 0) ? 1 : ticks;
+}
+
+static void MotorProfile_Output(MotorChannel_t* ch, MotorProfile_Instance_t* pr, int32_t pulse)
+{
+    if (pulse != pr->last_written)
+    {
+        MotorChannel_WritePulse(ch, pulse);
+        pr->last_written = pulse;
+    }
+}
+
+static void MotorProfile_Finish(MotorProfile_Instance_t* pr)
+{
+    pr->active = 0;
+    if (!MotorProfile_AnyActive()) __HAL_TIM_DISABLE_IT(&htim3, TIM_IT_UPDATE);
+}
+
+/**
+ * @brief Kanalın profilini derler ve çalışanın yerine başlatır
+ * Tüm kanallar TIM3 update kesmesinde aynı tick'te ilerler (TIM4 aynı periyotta).
+ * @retval HAL_BUSY: PID ana motoru sürüyor, HAL_ERROR: geçersiz profil
+ */
+HAL_StatusTypeDef MotorProfile_Start(MotorChannel_t* ch, const MotorSegment_t* segments, uint8_t count)
+{
+    MotorProfile_Instance_t* pr = MotorProfile_Of(ch);
+    uint32_t pwm_hz = Motor_PwmFrequency();
+    int32_t arr = MotorChannel_Period(ch);
+
+    uint8_t moves = 0;
+
+    if (count == 0 || count > MOTOR_PROFILE_MAX_SEGMENTS) return HAL_ERROR;
+    if (ch == MOTOR_MAIN && Pid_IsEnabled()) return HAL_BUSY;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (segments[i].type == MOTOR_SEG_MOVE && (segments[i].accel == 0 || ++moves > MOTOR_PROFILE_MAX_MOVES))
+        {
+            return HAL_ERROR;
+        }
+    }
+    moves = 0;
+
+    // DMA dalga formu ve komut kuyruğu da ana motorun CCR'lerini yazıyor - tek kaynak kalmalı
+    if (ch == MOTOR_MAIN && MotorWave_IsActive()) MotorWave_Stop();
+    if (ch == MOTOR_MAIN && MotorQueue_Depth() > 0) MotorQueue_Flush();
+
+    // Derleme sırasında ISR bu kanalı atlar: ilk rampa ISR'ın bıraktığı noktadan başlamalı
+    uint8_t was_active = pr->active;
+    pr->active = 0;
+
+    if (was_active) pr->stats.replaced++;
+    else pr->pos_q = MotorChannel_GetPulse(ch) * (1 << PROFILE_Q);
+    pr->last_written = pr->pos_q >> PROFILE_Q;
+
+    int32_t from = pr->pos_q >> PROFILE_Q;
+    pr->expected_ticks = 0;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const MotorSegment_t* seg = &segments[i];
+        MotorProfile_Step_t* st = &pr->steps[i];
+        int8_t duty = seg->duty;
+
+        if (duty > 100) duty = 100;
+        else if (duty < -100) duty = -100;
+
+        st->type = seg->type;
+        st->target = (int32_t)duty * arr / 100;
+        st->ticks = MotorProfile_MsToTicks(seg->time_ms, pwm_hz);
+        st->period = st->ticks + MotorProfile_MsToTicks(seg->off_ms, pwm_hz);
+        st->count = seg->count ? seg->count : 1;
+        st->step_q = 0;
+
+        if (seg->type == MOTOR_SEG_RAMP)
+        {
+            if (st->ticks == 0) st->ticks = 1;
+            // ±2·ARR açıklık Q15'te 32 biti aşabilir (tek tick'lik rampa); o durumda adım
+            // kullanılmaz - ISR son tick'te doğrudan hedefe atlar
+            int64_t step = ((int64_t)(st->target - from) * (1 << PROFILE_Q)) / (int64_t)st->ticks;
+            if (step > INT32_MAX) step = INT32_MAX;
+            else if (step < -INT32_MAX) step = -INT32_MAX;
+            st->step_q = (int32_t)step;
+        }
+
+        if (seg->type == MOTOR_SEG_MOVE)
+        {
+            int8_t end = seg->end_duty;
+            if (end > 100) end = 100;
+            else if (end < -100) end = -100;
+
+            SpeedProfile_Params_t params = {
+                .v_start = (float)from,
+                .v_peak = (float)st->target,
+                .v_end = (float)((int32_t)end * arr / 100),
+                .accel = (float)seg->accel * (float)arr / 100.0f,
+                .jerk = (float)seg->jerk * (float)arr / 100.0f,
+                .cruise_s = (float)seg->time_ms / 1000.0f,
+            };
+            st->move = moves++;
+            SpeedProfile_Plan(&pr->move_plans[st->move], &params, (float)pwm_hz);
+            st->ticks = pr->move_plans[st->move].total_ticks;
+            st->target = pr->move_plans[st->move].v_end;
+        }
+
+        if (seg->type == MOTOR_SEG_BRAKE && st->target < 0) st->target = -st->target;
+
+        // Beklenen tamamlanma süresi
+        if (seg->type == MOTOR_SEG_HOLD && st->ticks == 0) pr->expected_ticks = MOTOR_PROFILE_OPEN_ENDED;
+        if (pr->expected_ticks != MOTOR_PROFILE_OPEN_ENDED)
+        {
+            pr->expected_ticks += (seg->type == MOTOR_SEG_PULSE) ? st->period * st->count : st->ticks;
+        }
+
+        from = (seg->type == MOTOR_SEG_PULSE || seg->type == MOTOR_SEG_BRAKE) ? 0 : st->target;
+    }
+    pr->expected_ms = (pr->expected_ticks == MOTOR_PROFILE_OPEN_ENDED) ? MOTOR_PROFILE_OPEN_ENDED :
+                      (uint32_t)(((uint64_t)pr->expected_ticks * 1000 + pwm_hz / 2) / pwm_hz);
+
+    if (pr->steps[0].type == MOTOR_SEG_MOVE) SpeedProfile_Begin(&pr->move_state, &pr->move_plans[pr->steps[0].move]);
+    pr->step_count = count;
+    pr->step_index = 0;
+    pr->step_tick = 0;
+    pr->pulse_index = 0;
+    pr->stats.started++;
+
+    // Başka kanal koşuyorsa bekleyen update bayrağı onun tick'idir - silinmez
+    if (!MotorProfile_AnyActive()) __HAL_TIM_CLEAR_FLAG(&htim3, TIM_FLAG_UPDATE);
+    pr->active = 1;
+    __HAL_TIM_ENABLE_IT(&htim3, TIM_IT_UPDATE);
+    return HAL_OK;
+}
+
+/**
+ * @brief Kanalın profilini keser ve motoru durdurur
+ */
+void MotorProfile_Cancel(MotorChannel_t* ch)
+{
+    MotorProfile_Instance_t* pr = MotorProfile_Of(ch);
+
+    if (pr->active)
+    {
+        pr->active = 0;
+        pr->stats.cancelled++;
+    }
+    if (!MotorProfile_AnyActive()) __HAL_TIM_DISABLE_IT(&htim3, TIM_IT_UPDATE);
+    pr->pos_q = 0;
+    pr->last_written = 0;
+    MotorChannel_WritePulse(ch, 0);
+}
+
+uint8_t MotorProfile_IsActive(const MotorChannel_t* ch)
+{
+    return MotorProfile_Of(ch)->active;
+}
+
+/**
+ * @brief Bir kanalı bir PWM periyodu ilerlet
+ */
+static void MotorProfile_Step(MotorChannel_t* ch, MotorProfile_Instance_t* pr)
+{
+    uint8_t next = 0;
+    const MotorProfile_Step_t* st = &pr->steps[pr->step_index];
+    pr->step_tick++;
+
+    switch (st->type)
+    {
+    case MOTOR_SEG_RAMP:
+        if (pr->step_tick >= st->ticks)
+        {
+            pr->pos_q = st->target * (1 << PROFILE_Q);
+            next = 1;
+        }
+        else
+        {
+            pr->pos_q += st->step_q;    // Ara adımlar hedefi aşmaz - taşma yok
+        }
+        break;
+
+    case MOTOR_SEG_HOLD:
+        pr->pos_q = st->target * (1 << PROFILE_Q);
+        if (st->ticks != 0 && pr->step_tick >= st->ticks) next = 1;
+        break;
+
+    case MOTOR_SEG_PULSE:
+        pr->pos_q = (pr->step_tick <= st->ticks) ? st->target * (1 << PROFILE_Q) : 0;
+        if (pr->step_tick >= st->period)
+        {
+            pr->step_tick = 0;
+            if (++pr->pulse_index >= st->count)
+            {
+                pr->pos_q = 0;    // Darbe dizisi kapalıda biter
+                next = 1;
+            }
+        }
+        break;
+
+    case MOTOR_SEG_BRAKE:
+        // Fren çıkışı Output'tan geçmez: last_written 0 tutulur, 0 yazılıp fren bozulmasın
+        pr->pos_q = 0;
+        if (pr->step_tick == 1)
+        {
+            MotorChannel_WriteBrake(ch, st->target);
+            pr->last_written = 0;
+        }
+        if (pr->step_tick >= st->ticks)
+        {
+            MotorChannel_WritePulse(ch, 0);     // Fren bitti - serbest
+            next = 1;
+        }
+        break;
+
+    case MOTOR_SEG_MOVE:
+    {
+        int32_t out;
+        if (!SpeedProfile_Step(&pr->move_state, &out)) next = 1;
+        pr->pos_q = out * (1 << PROFILE_Q);
+        if (pr->step_tick >= st->ticks) next = 1;
+        break;
+    }
+    }
+
+    MotorProfile_Output(ch, pr, pr->pos_q >> PROFILE_Q);
+
+    if (next)
+    {
+        pr->step_tick = 0;
+        pr->pulse_index = 0;
+        if (++pr->step_index >= pr->step_count)
+        {
+            pr->stats.completed++;
+            MotorProfile_Finish(pr);
+        }
+        else if (pr->steps[pr->step_index].type == MOTOR_SEG_MOVE)
+        {
+            SpeedProfile_Begin(&pr->move_state, &pr->move_plans[pr->steps[pr->step_index].move]);
+        }
+    }
+}
+
+/**
+ * @brief Tüm aktif kanalları bir PWM periyodu ilerlet - TIM3 update kesmesinden çağrılır
+ */
+void MotorProfile_Tick(void)
+{
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        if (profiles[i].active) MotorProfile_Step(&motor_channels[i], &profiles[i]);
+    }
+}
+
+/**
+ * @brief Kanalda son başlatılan profilin beklenen süresi (ms), süresizse MOTOR_PROFILE_OPEN_ENDED
+ */
+uint32_t MotorProfile_ExpectedMs(const MotorChannel_t* ch)
+{
+    return MotorProfile_Of(ch)->expected_ms;
+}
+
+void MotorProfile_Report(const MotorChannel_t* ch)
+{
+    const MotorProfile_Instance_t* pr = MotorProfile_Of(ch);
+    char msg[112];
+    char eta[12];
+
+    if (pr->expected_ms == MOTOR_PROFILE_OPEN_ENDED) strcpy(eta, "inf");
+    else sprintf(eta, "%lums", pr->expected_ms);
+
+    sprintf(msg, "Profile %s[%s Seg:%u/%u Out:%ld T:%s Start:%lu Done:%lu Repl:%lu Cancel:%lu]\r\n",
+            ch->name, pr->active ? "RUN" : "IDLE", pr->step_index, pr->step_count, (long)pr->last_written, eta,
+            pr->stats.started, pr->stats.completed, pr->stats.replaced, pr->stats.cancelled);
+    SendDebugMessage(msg);
+}
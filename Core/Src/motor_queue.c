@@ -0,0 +1,159 @@
+#include "motor_queue.h"
+#include "motor.h"
+#include "motor_profile.h"
+#include "motor_wave.h"
+#include "pid.h"
+#include "tim.h"
+#include <stdio.h>
+
+#define MOTOR_QUEUE_MASK    (MOTOR_QUEUE_SIZE - 1)
+
+#if (MOTOR_QUEUE_SIZE & MOTOR_QUEUE_MASK) != 0
+#error "MOTOR_QUEUE_SIZE 2'nin kuvveti olmalı"
+#endif
+
+volatile MotorQueue_Stats_t motor_queue_stats;
+
+static MotorCommand_t queue[MOTOR_QUEUE_SIZE];
+static volatile uint32_t queue_head = 0;    // Sadece üretici yazar
+static volatile uint32_t queue_tail = 0;    // Sadece tüketici (ISR) yazar
+static volatile uint8_t flush_request = 0;
+static uint32_t last_time_us = 0;
+
+/**
+ * @brief TIM2 compare kesmesini tetikler - ISR baştaki komuta göre CCR1'i kurar
+ */
+static void MotorQueue_Kick(void)
+{
+    TIM2->EGR = TIM_EGR_CC1G;
+}
+
+/**
+ * @brief TIM2 serbest sayacını ve CC1 kesmesini başlatır
+ */
+void MotorQueue_Init(void)
+{
+    queue_head = 0;
+    queue_tail = 0;
+    flush_request = 0;
+    memset((void*)&motor_queue_stats, 0, sizeof(motor_queue_stats));
+
+    HAL_TIM_OC_Start_IT(&htim2, TIM_CHANNEL_1);
+}
+
+/**
+ * @brief Komutu kuyruğa ekler (üretici - ana döngü)
+ *        Ana motor tek kaynaktan sürülür: çalışan profil (olay davranışları dahil)
+ *        ve dalga formu durdurulur; onlar başlarsa da kuyruk boşaltılır
+ * @retval HAL_BUSY: PID motoru sürüyor, HAL_ERROR: kuyruk dolu
+ */
+HAL_StatusTypeDef MotorQueue_Push(uint32_t time_us, uint8_t duty, uint8_t direction)
+{
+    uint32_t head = queue_head;
+    uint32_t depth = head - queue_tail;
+
+    if (Pid_IsEnabled()) return HAL_BUSY;
+    if (depth >= MOTOR_QUEUE_SIZE)
+    {
+        motor_queue_stats.overruns++;
+        return HAL_ERROR;
+    }
+
+    if (MotorProfile_IsActive(MOTOR_MAIN)) MotorProfile_Cancel(MOTOR_MAIN);
+    if (MotorWave_IsActive()) MotorWave_Stop();
+
+    MotorCommand_t* cmd = &queue[head & MOTOR_QUEUE_MASK];
+    cmd->time_us = time_us;
+    cmd->duty = (duty > 100) ? 100 : duty;
+    cmd->direction = direction;
+
+    __DMB();                // Komut, indeks görünmeden önce belleğe yazılmış olmalı
+    queue_head = head + 1;
+
+    last_time_us = time_us;
+    motor_queue_stats.pushed++;
+    if (depth + 1 > motor_queue_stats.high_water) motor_queue_stats.high_water = depth + 1;
+
+    MotorQueue_Kick();
+    return HAL_OK;
+}
+
+uint32_t MotorQueue_Depth(void)
+{
+    return queue_head - queue_tail;
+}
+
+/**
+ * @brief Kuyruktaki son komutun zamanı - kuyruk boşsa şimdiki zaman
+ */
+uint32_t MotorQueue_LastTime(void)
+{
+    return (MotorQueue_Depth() > 0) ? last_time_us : MotorQueue_Now();
+}
+
+/**
+ * @brief Bekleyen komutları atar (tail ISR'a ait olduğu için istek olarak)
+ */
+void MotorQueue_Flush(void)
+{
+    flush_request = 1;
+    MotorQueue_Kick();
+}
+
+/**
+ * @brief Tüketici - vadesi gelen komutları uygular, sonrakine CCR1 kurar
+ */
+static void MotorQueue_Service(void)
+{
+    if (flush_request)
+    {
+        queue_tail = queue_head;
+        flush_request = 0;
+    }
+
+    while (queue_tail != queue_head)
+    {
+        uint32_t tail = queue_tail;
+        const MotorCommand_t* cmd = &queue[tail & MOTOR_QUEUE_MASK];
+        int32_t wait = (int32_t)(cmd->time_us - TIM2->CNT);
+
+        if (wait > 0)
+        {
+            TIM2->CCR1 = cmd->time_us;
+            // CCR yazılırken zaman geçtiyse eşleşme kaçar - tekrar kontrol et
+            if ((int32_t)(cmd->time_us - TIM2->CNT) > 0) return;
+            continue;
+        }
+
+        HW153_WriteDuty(cmd->duty, cmd->direction);
+
+        uint32_t late = (uint32_t)(-wait);
+        if (late > motor_queue_stats.late_max_us) motor_queue_stats.late_max_us = late;
+        motor_queue_stats.late_sum_us += late;
+        motor_queue_stats.applied++;
+
+        __DMB();            // Slot okunduktan sonra serbest bırakılır
+        queue_tail = tail + 1;
+    }
+}
+
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM2 && htim->Channel == HAL_TIM_ACTIVE_CHANNEL_1)
+    {
+        MotorQueue_Service();
+    }
+}
+
+void MotorQueue_Report(void)
+{
+    char msg[112];
+    uint32_t applied = motor_queue_stats.applied;
+
+    sprintf(msg, "MQ[Depth:%lu HW:%lu Push:%lu Done:%lu Ovr:%lu Late:%lu/%luus]\r\n",
+            MotorQueue_Depth(), motor_queue_stats.high_water, motor_queue_stats.pushed,
+            applied, motor_queue_stats.overruns,
+            applied ? motor_queue_stats.late_sum_us / applied : 0,
+            motor_queue_stats.late_max_us);
+    SendDebugMessage(msg);
+}
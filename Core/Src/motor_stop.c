@@ -0,0 +1,181 @@
+#include "motor_stop.h"
+#include "motor_profile.h"
+#include "encoder.h"
+#include "pid.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+MotorStop_Config_t motor_stop_config;
+MotorStop_Stats_t motor_stop_stats[2];
+
+static volatile uint8_t measuring = 0;
+static volatile uint8_t finished = 0;       // Task raporlasın
+static MotorStop_Source_t source = MOTOR_STOP_SRC_NONE;
+static Motor_StopMode_t stop_mode = MOTOR_STOP_COAST;
+static uint32_t start_ms = 0;
+static uint32_t below_since = 0;
+static uint32_t result_ms = 0;
+static uint8_t timed_out = 0;
+static float start_speed = 0.0f;
+static float last_gyro_dps = 0.0f;
+
+static const char* const mode_names[] = { "COAST", "BRAKE" };
+static const char* const source_names[] = { "-", "RPM", "GYRO" };
+
+/**
+ * @brief Varsayılan: 20 rpm / 2 dps eşiği, 20 ms kararlılık, 5 s zaman aşımı
+ */
+void MotorStop_Init(void)
+{
+    motor_stop_config.stop_rpm = 20.0f;
+    motor_stop_config.stop_dps = 2.0f;
+    motor_stop_config.settle_ms = 20;
+    motor_stop_config.timeout_ms = 5000;
+    memset(motor_stop_stats, 0, sizeof(motor_stop_stats));
+    measuring = 0;
+    finished = 0;
+}
+
+/**
+ * @brief Durmayı başlatır ve süre ölçümünü kurar
+ * @param brake_ms: BRAKE kipinde fren süresi, sonra serbest
+ * @param strength: fren oranı % (1..100)
+ * @retval HAL_BUSY: PID motoru sürüyor, HAL_ERROR: geçersiz parametre
+ */
+HAL_StatusTypeDef MotorStop_Begin(Motor_StopMode_t mode, uint16_t brake_ms, uint8_t strength)
+{
+    MotorSegment_t seg = {0};
+
+    if (mode == MOTOR_STOP_BRAKE && (brake_ms == 0 || strength == 0 || strength > 100)) return HAL_ERROR;
+    if (Pid_IsEnabled()) return HAL_BUSY;
+
+    // Kaynak: encoder dönüyorsa rpm, değilse gyro
+    float rpm = fabsf(Encoder_GetRpm());
+    if (rpm > motor_stop_config.stop_rpm)
+    {
+        source = MOTOR_STOP_SRC_RPM;
+        start_speed = rpm;
+    }
+    else if (last_gyro_dps > motor_stop_config.stop_dps)
+    {
+        source = MOTOR_STOP_SRC_GYRO;
+        start_speed = last_gyro_dps;
+    }
+    else
+    {
+        source = MOTOR_STOP_SRC_NONE;
+        start_speed = 0.0f;
+    }
+
+    if (mode == MOTOR_STOP_BRAKE)
+    {
+        seg.type = MOTOR_SEG_BRAKE;
+        seg.duty = (int8_t)strength;
+        seg.time_ms = brake_ms;
+    }
+    else
+    {
+        seg.type = MOTOR_SEG_HOLD;      // 0 çıkış = serbest
+        seg.time_ms = 1;
+    }
+
+    __disable_irq();
+    stop_mode = mode;
+    start_ms = HAL_GetTick();
+    below_since = 0;
+    timed_out = 0;
+    finished = 0;
+    measuring = (source != MOTOR_STOP_SRC_NONE);
+    __enable_irq();
+
+    return MotorProfile_Start(MOTOR_MAIN, &seg, 1);
+}
+
+uint8_t MotorStop_IsMeasuring(void)
+{
+    return measuring;
+}
+
+static void MotorStop_Check(float speed)
+{
+    uint32_t now = HAL_GetTick();
+
+    if (speed <= ((source == MOTOR_STOP_SRC_RPM) ? motor_stop_config.stop_rpm : motor_stop_config.stop_dps))
+    {
+        if (below_since == 0) below_since = now;
+        if (now - below_since >= motor_stop_config.settle_ms)
+        {
+            result_ms = below_since - start_ms;
+            measuring = 0;
+            finished = 1;
+        }
+    }
+    else
+    {
+        below_since = 0;
+    }
+
+    if (measuring && now - start_ms >= motor_stop_config.timeout_ms)
+    {
+        result_ms = now - start_ms;
+        timed_out = 1;
+        measuring = 0;
+        finished = 1;
+    }
+}
+
+/**
+ * @brief rpm kaynağı - kontrol tick'inden (Encoder_Tick sonrası)
+ */
+void MotorStop_Tick(void)
+{
+    if (measuring && source == MOTOR_STOP_SRC_RPM) MotorStop_Check(fabsf(Encoder_GetRpm()));
+}
+
+/**
+ * @brief gyro kaynağı - örnekleme döngüsünden
+ */
+void MotorStop_GyroSample(float magnitude)
+{
+    last_gyro_dps = magnitude;
+    if (measuring && source == MOTOR_STOP_SRC_GYRO) MotorStop_Check(magnitude);
+}
+
+/**
+ * @brief Ana döngü - biten ölçümü istatistiğe ekler ve raporlar
+ */
+void MotorStop_Task(void)
+{
+    if (!finished) return;
+    finished = 0;
+
+    MotorStop_Stats_t* st = &motor_stop_stats[stop_mode];
+    if (timed_out)
+    {
+        st->timeouts++;
+    }
+    else
+    {
+        st->count++;
+        st->last_ms = result_ms;
+        st->sum_ms += result_ms;
+        if (st->best_ms == 0 || result_ms < st->best_ms) st->best_ms = result_ms;
+    }
+    MotorStop_Report();
+}
+
+void MotorStop_Report(void)
+{
+    char msg[192];
+    const MotorStop_Stats_t* c = &motor_stop_stats[MOTOR_STOP_COAST];
+    const MotorStop_Stats_t* b = &motor_stop_stats[MOTOR_STOP_BRAKE];
+
+    sprintf(msg, "Stop[%s %s %.1f -> %s%lums | COAST n:%lu ort:%lu best:%lu to:%lu | BRAKE n:%lu ort:%lu best:%lu to:%lu | Def:%s]\r\n",
+            mode_names[stop_mode], source_names[source], start_speed,
+            measuring ? "..." : (timed_out ? ">" : ""), measuring ? HAL_GetTick() - start_ms : result_ms,
+            c->count, c->count ? c->sum_ms / c->count : 0, c->best_ms, c->timeouts,
+            b->count, b->count ? b->sum_ms / b->count : 0, b->best_ms, b->timeouts,
+            mode_names[Motor_GetStopMode()]);
+    SendDebugMessage(msg);
+}
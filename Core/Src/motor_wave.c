@@ -0,0 +1,409 @@
+#include "motor_wave.h"
+#include "motor.h"
+#include "motor_profile.h"
+#include "motor_queue.h"
+#include "pid.h"
+#include "tim.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MOTOR_WAVE_HALF         (MOTOR_WAVE_MAX_SAMPLES / 2)
+#define MOTOR_WAVE_QUEUE_MASK   (MOTOR_WAVE_QUEUE_SIZE - 1)
+
+#if (MOTOR_WAVE_MAX_SAMPLES & 1) != 0
+#error "MOTOR_WAVE_MAX_SAMPLES çift olmalı"
+#endif
+#if (MOTOR_WAVE_QUEUE_SIZE & MOTOR_WAVE_QUEUE_MASK) != 0
+#error "MOTOR_WAVE_QUEUE_SIZE 2'nin kuvveti olmalı"
+#endif
+
+// Akış segmenti - süreler PWM periyoduna çevrilmiş; duty çalınırken compare'e
+// çevrilir (MLIM sınırı/polaritesi o anki değerle)
+typedef struct {
+    int16_t duty;           // -MOTOR_DUTY_FULL..MOTOR_DUTY_FULL
+    uint32_t on_periods;
+    uint32_t off_periods;   // 0: darbe yok, sürekli
+    uint16_t count;
+} MotorWave_Segment_t;
+
+volatile MotorWave_Stats_t motor_wave_stats;
+
+// DMA burst sırası: her update olayında CCR1, CCR2
+static uint16_t wave_buffer[MOTOR_WAVE_MAX_SAMPLES * 2];
+// Döngü dalgasının ham duty'si - compare'ler Play'de kanal sınırı/polaritesiyle üretilir
+static int16_t wave_duty[MOTOR_WAVE_MAX_SAMPLES];
+static uint16_t loaded_samples = 0;     // 0: geçerli döngü dalgası yok
+static uint32_t loaded_arr = 0;
+static volatile MotorWave_Mode_t wave_mode = MOTOR_WAVE_IDLE;
+static uint16_t loops_target = 0;
+static uint16_t loops_done = 0;
+
+// Akış kuyruğu - üretici ana döngü, tüketici DMA kesmesi
+static MotorWave_Segment_t queue[MOTOR_WAVE_QUEUE_SIZE];
+static volatile uint32_t queue_head = 0;
+static volatile uint32_t queue_tail = 0;
+
+// Tüketici durumu (sadece DMA kesmesi / DMA kapalıyken)
+static MotorWave_Segment_t segment;
+static uint16_t segment_compare[2];     // Segmentin CCR1/CCR2 çifti
+static uint8_t segment_active = 0;
+static uint8_t run_off = 0;
+static uint16_t run_count = 0;
+static uint16_t run_compare[2];
+static int32_t run_pulse = 0;           // Segmentin komut pulse'ı (ch->pulse için)
+static uint32_t run_left = 0;
+static uint8_t empty_halves = 0;
+
+static uint32_t MotorWave_MsToPeriods(uint32_t ms)
+{
+    return (uint32_t)(((uint64_t)ms * Motor_PwmFrequency() + 500) / 1000);
+}
+
+/**
+ * @brief Sıradaki sabit compare parçasını (run) hazırlar
+ * @retval 1: hazır, 0: kuyruk boş
+ */
+static uint8_t MotorWave_NextRun(void)
+{
+    for (;;)
+    {
+        if (segment_active)
+        {
+            if (!run_off && segment.off_periods > 0)
+            {
+                run_off = 1;
+                run_compare[0] = 0;
+                run_compare[1] = 0;
+                run_left = segment.off_periods;
+                MOTOR_MAIN->pulse = 0;
+                return 1;
+            }
+            if (--run_count > 0)
+            {
+                run_off = 0;
+                run_compare[0] = segment_compare[0];
+                run_compare[1] = segment_compare[1];
+                run_left = segment.on_periods;
+                MOTOR_MAIN->pulse = run_pulse;
+                return 1;
+            }
+            segment_active = 0;
+        }
+
+        if (queue_tail == queue_head) return 0;
+
+        segment = queue[queue_tail & MOTOR_WAVE_QUEUE_MASK];
+        __DMB();            // Slot kopyalandıktan sonra serbest bırakılır
+        queue_tail++;
+        motor_wave_stats.segments++;
+
+        // Çarp-kaydır, bölme yok: DMA kesmesinde çevrilebilir
+        run_pulse = MotorChannel_DutyToCompare(MOTOR_MAIN, segment.duty, segment_compare);
+        segment_active = 1;
+        run_off = 0;
+        run_count = segment.count;
+        run_compare[0] = segment_compare[0];
+        run_compare[1] = segment_compare[1];
+        run_left = segment.on_periods;
+        MOTOR_MAIN->pulse = run_pulse;
+        return 1;
+    }
+}
+
+/**
+ * @brief Yarım tamponu kuyruktan doldurur, kalan kısım sıfır (coast)
+ * @retval Kuyruktan gelen örnek sayısı
+ */
+static uint16_t MotorWave_Fill(uint16_t* dst, uint16_t samples)
+{
+    uint16_t written = 0;
+
+    while (written < samples)
+    {
+        if (run_left == 0 && !MotorWave_NextRun()) break;
+
+        uint32_t n = samples - written;
+        if (n > run_left) n = run_left;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            *dst++ = run_compare[0];
+            *dst++ = run_compare[1];
+        }
+        written += (uint16_t)n;
+        run_left -= n;
+    }
+
+    memset(dst, 0, (size_t)(samples - written) * 2 * sizeof(uint16_t));
+    return written;
+}
+
+static void MotorWave_Finish(void)
+{
+    __HAL_TIM_DISABLE_DMA(&htim3, TIM_DMA_UPDATE);
+    HAL_DMA_Abort(&hdma_tim3_up);
+    wave_mode = MOTOR_WAVE_IDLE;
+    HW153_WritePulse(0);
+}
+
+/**
+ * @brief Akış: DMA diğer yarıyı çalarken biten yarıyı doldur
+ * Kuyruk iki yarı üst üste boş kalırsa son veri çalınmıştır - akış durur.
+ */
+static void MotorWave_Refill(uint8_t half)
+{
+    motor_wave_stats.refills++;
+
+    if (MotorWave_Fill(&wave_buffer[half * MOTOR_WAVE_HALF * 2], MOTOR_WAVE_HALF) > 0)
+    {
+        empty_halves = 0;
+    }
+    else if (++empty_halves >= 2)
+    {
+        MotorWave_Finish();
+    }
+}
+
+static void MotorWave_DmaHalf(DMA_HandleTypeDef* hdma)
+{
+    (void)hdma;
+    MotorWave_Refill(0);
+}
+
+static void MotorWave_DmaComplete(DMA_HandleTypeDef* hdma)
+{
+    (void)hdma;
+
+    if (wave_mode == MOTOR_WAVE_STREAM)
+    {
+        MotorWave_Refill(1);
+    }
+    else if (wave_mode == MOTOR_WAVE_LOOP)
+    {
+        motor_wave_stats.loops++;
+        if (loops_target != 0 && ++loops_done >= loops_target) MotorWave_Finish();
+    }
+}
+
+static void MotorWave_DmaError(DMA_HandleTypeDef* hdma)
+{
+    (void)hdma;
+    motor_wave_stats.dma_errors++;
+    MotorWave_Finish();
+}
+
+/**
+ * @brief Çalışanı durdurur ve motoru tek kaynağa bırakır
+ * Sadece DMA kesilir: akış kuyruğu korunur (WQ hemen ardından WSTREAM ile
+ * çalınabilsin), kuyruğu yalnız MotorWave_Stop (WSTOP) boşaltır.
+ * @retval HAL_BUSY: PID motoru sürüyor
+ */
+static HAL_StatusTypeDef MotorWave_Claim(void)
+{
+    if (Pid_IsEnabled()) return HAL_BUSY;
+    if (wave_mode != MOTOR_WAVE_IDLE)
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        MotorWave_Finish();
+        __set_PRIMASK(primask);
+    }
+    if (MotorProfile_IsActive(MOTOR_MAIN)) MotorProfile_Cancel(MOTOR_MAIN);
+    if (MotorQueue_Depth() > 0) MotorQueue_Flush();
+    return HAL_OK;
+}
+
+/**
+ * @brief TIM3 update DMA'sını CCR1/CCR2 burst'üne bağlar ve başlatır
+ */
+static HAL_StatusTypeDef MotorWave_StartDma(uint16_t samples, MotorWave_Mode_t mode)
+{
+    TIM3->DCR = TIM_DMABASE_CCR1 | TIM_DMABURSTLENGTH_2TRANSFERS;
+
+    hdma_tim3_up.XferCpltCallback = MotorWave_DmaComplete;
+    hdma_tim3_up.XferHalfCpltCallback = (mode == MOTOR_WAVE_STREAM) ? MotorWave_DmaHalf : NULL;
+    hdma_tim3_up.XferErrorCallback = MotorWave_DmaError;
+
+    wave_mode = mode;
+    if (HAL_DMA_Start_IT(&hdma_tim3_up, (uint32_t)wave_buffer, (uint32_t)&TIM3->DMAR,
+                         (uint32_t)samples * 2) != HAL_OK)
+    {
+        wave_mode = MOTOR_WAVE_IDLE;
+        return HAL_ERROR;
+    }
+    __HAL_TIM_ENABLE_DMA(&htim3, TIM_DMA_UPDATE);
+    motor_wave_stats.started++;
+    return HAL_OK;
+}
+
+/**
+ * @brief Döngü dalga formunu yükler
+ * @param duty: örnekler, -MOTOR_DUTY_FULL..MOTOR_DUTY_FULL (işaret = yön)
+ * @param hold: her örnek kaç PWM periyodu sürer (tamponda açılır)
+ * @retval HAL_BUSY: dalga çalıyor, HAL_ERROR: tampona sığmıyor
+ */
+HAL_StatusTypeDef MotorWave_Load(const int16_t* duty, uint16_t count, uint16_t hold)
+{
+    if (wave_mode != MOTOR_WAVE_IDLE) return HAL_BUSY;
+    if (count == 0 || hold == 0 || (uint32_t)count * hold > MOTOR_WAVE_MAX_SAMPLES) return HAL_ERROR;
+
+    int16_t* dst = wave_duty;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        int16_t d = duty[i];
+        if (d > MOTOR_DUTY_FULL) d = MOTOR_DUTY_FULL;
+        else if (d < -MOTOR_DUTY_FULL) d = -MOTOR_DUTY_FULL;
+        for (uint16_t k = 0; k < hold; k++) *dst++ = d;
+    }
+
+    loaded_samples = count * hold;
+    loaded_arr = __HAL_TIM_GET_AUTORELOAD(&htim3);
+    return HAL_OK;
+}
+
+/**
+ * @brief Tek periyotluk hazır dalga formu üretip yükler (kayan nokta burada, ISR'da değil)
+ * @param amplitude: tepe duty, 0..MOTOR_DUTY_FULL
+ * @param period_ms: dalga periyodu - PWM periyodu başına bir örnek tampona sığmalı
+ *                   (20 kHz'de en fazla 25 ms; daha uzun desenler akış kipiyle)
+ */
+HAL_StatusTypeDef MotorWave_Generate(MotorWave_Shape_t shape, int32_t amplitude, uint32_t period_ms)
+{
+    uint32_t samples = MotorWave_MsToPeriods(period_ms);
+
+    if (wave_mode != MOTOR_WAVE_IDLE) return HAL_BUSY;
+    if (shape >= MOTOR_WAVE_SHAPE_COUNT || amplitude <= 0) return HAL_ERROR;
+    if (samples < 2 || samples > MOTOR_WAVE_MAX_SAMPLES) return HAL_ERROR;
+    if (amplitude > MOTOR_DUTY_FULL) amplitude = MOTOR_DUTY_FULL;
+
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        float phase = (float)i / (float)samples;
+        float value;
+
+        if (shape == MOTOR_WAVE_SINE) value = sinf(2.0f * (float)M_PI * phase);
+        else if (shape == MOTOR_WAVE_SQUARE) value = (phase < 0.5f) ? 1.0f : 0.0f;
+        else value = (phase < 0.5f) ? 2.0f * phase : 2.0f * (1.0f - phase);
+
+        wave_duty[i] = (int16_t)lroundf(value * (float)amplitude);
+    }
+
+    loaded_samples = (uint16_t)samples;
+    loaded_arr = __HAL_TIM_GET_AUTORELOAD(&htim3);
+    return HAL_OK;
+}
+
+/**
+ * @brief Yüklü dalgayı döngüde çalar - çalışan profili/dalgayı değiştirir
+ * Compare çiftleri burada, DMA kapalıyken ana kanalın o anki sınırı ve
+ * polaritesiyle üretilir (MLIM yüklemeden sonra da geçerli). ch->pulse ilk
+ * örneği gösterir, dalga bitince 0'lanır.
+ * @param loops: tekrar sayısı, 0 = durdurulana kadar
+ * @retval HAL_BUSY: PID aktif, HAL_ERROR: dalga yok veya PWM ayarı değişmiş
+ */
+HAL_StatusTypeDef MotorWave_Play(uint16_t loops)
+{
+    HAL_StatusTypeDef status = MotorWave_Claim();
+    if (status != HAL_OK) return status;
+    if (loaded_samples == 0 || loaded_arr != __HAL_TIM_GET_AUTORELOAD(&htim3)) return HAL_ERROR;
+
+    int32_t first = 0;
+    for (uint16_t i = 0; i < loaded_samples; i++)
+    {
+        int32_t pulse = MotorChannel_DutyToCompare(MOTOR_MAIN, wave_duty[i], &wave_buffer[2 * i]);
+        if (i == 0) first = pulse;
+    }
+    MOTOR_MAIN->pulse = first;
+
+    loops_target = loops;
+    loops_done = 0;
+    return MotorWave_StartDma(loaded_samples, MOTOR_WAVE_LOOP);
+}
+
+/**
+ * @brief Akış kuyruğuna segment ekler (üretici - ana döngü)
+ * @param duty: -MOTOR_DUTY_FULL..MOTOR_DUTY_FULL
+ * @param off_ms: 0 değilse on_ms açık / off_ms kapalı darbe, count kez
+ * @retval HAL_BUSY: PID aktif, HAL_ERROR: kuyruk dolu veya geçersiz süre
+ */
+HAL_StatusTypeDef MotorWave_Queue(int32_t duty, uint32_t on_ms, uint32_t off_ms, uint16_t count)
+{
+    uint32_t head = queue_head;
+
+    if (Pid_IsEnabled()) return HAL_BUSY;
+    if (on_ms == 0 || count == 0) return HAL_ERROR;
+    if (head - queue_tail >= MOTOR_WAVE_QUEUE_SIZE)
+    {
+        motor_wave_stats.queue_full++;
+        return HAL_ERROR;
+    }
+
+    MotorWave_Segment_t* seg = &queue[head & MOTOR_WAVE_QUEUE_MASK];
+    if (duty > MOTOR_DUTY_FULL) duty = MOTOR_DUTY_FULL;
+    else if (duty < -MOTOR_DUTY_FULL) duty = -MOTOR_DUTY_FULL;
+    seg->duty = (int16_t)duty;
+    seg->on_periods = MotorWave_MsToPeriods(on_ms);
+    if (seg->on_periods == 0) seg->on_periods = 1;
+    seg->off_periods = MotorWave_MsToPeriods(off_ms);
+    seg->count = count;
+
+    __DMB();                // Segment, indeks görünmeden önce belleğe yazılmış olmalı
+    queue_head = head + 1;
+    return HAL_OK;
+}
+
+/**
+ * @brief Kuyruktaki segmentleri çift tamponla çalmaya başlar
+ * Akış zaten çalışıyorsa yeni segmentler sırayla çalınır, bir şey yapılmaz.
+ */
+HAL_StatusTypeDef MotorWave_Stream(void)
+{
+    if (wave_mode == MOTOR_WAVE_STREAM) return HAL_OK;
+
+    HAL_StatusTypeDef status = MotorWave_Claim();
+    if (status != HAL_OK) return status;
+
+    // DMA kapalı: tüketici durumu burada sıfırlanabilir
+    segment_active = 0;
+    run_left = 0;
+    empty_halves = 0;
+
+    if (MotorWave_Fill(wave_buffer, MOTOR_WAVE_MAX_SAMPLES) == 0) return HAL_ERROR;
+    return MotorWave_StartDma(MOTOR_WAVE_MAX_SAMPLES, MOTOR_WAVE_STREAM);
+}
+
+/**
+ * @brief Çalmayı keser, akış kuyruğunu boşaltır ve motoru durdurur
+ */
+void MotorWave_Stop(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (wave_mode != MOTOR_WAVE_IDLE) MotorWave_Finish();
+    queue_tail = queue_head;
+    segment_active = 0;
+    run_left = 0;
+
+    __set_PRIMASK(primask);
+}
+
+uint8_t MotorWave_IsActive(void)
+{
+    return wave_mode != MOTOR_WAVE_IDLE;
+}
+
+void MotorWave_Report(void)
+{
+    static const char* const mode_names[] = { "IDLE", "LOOP", "STREAM" };
+    char msg[144];
+    uint32_t pwm_hz = Motor_PwmFrequency();
+
+    sprintf(msg, "Wave[%s Yuk:%u ornek/%.1fms Q:%lu Start:%lu Loop:%lu Refill:%lu Seg:%lu Full:%lu Err:%lu]\r\n",
+            mode_names[wave_mode], loaded_samples,
+            pwm_hz ? 1000.0f * (float)loaded_samples / (float)pwm_hz : 0.0f,
+            queue_head - queue_tail, motor_wave_stats.started, motor_wave_stats.loops,
+            motor_wave_stats.refills, motor_wave_stats.segments,
+            motor_wave_stats.queue_full, motor_wave_stats.dma_errors);
+    SendDebugMessage(msg);
+}
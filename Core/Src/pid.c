@@ -0,0 +1,276 @@
+#include "pid.h"
+#include "control.h"
+#include "motor.h"
+#include "motion_event.h"
+#include "motor_profile.h"
+#include "motor_wave.h"
+#include "motor_queue.h"
+#include "motor_stop.h"
+#include "motor_ident.h"
+#include "pid_tune.h"
+#include "encoder.h"
+#include "flash_store.h"
+#include "rate_predict.h"
+#include <math.h>
+#include <stdio.h>
+
+Pid_Config_t pid_config;
+volatile Pid_Status_t pid_status;
+
+static volatile float sensor_gyro[3];
+static volatile float sensor_angle[3];
+static volatile float sensor_external;
+static volatile uint8_t pid_enabled = 0;
+
+static float d_alpha;           // Türev filtresi katsayısı (ana döngüde hesaplanır)
+static float prev_measurement;
+static uint8_t has_prev = 0;
+static int32_t last_out = INT32_MIN;    // Son yazılan hassas duty
+
+static const char* const pid_source_names[PID_FB_COUNT] = { "RATE", "ANGLE", "EXT", "RPM" };
+
+// Flash'ta saklanan kısım - yapı değişirse uzunluk tutmaz, kayıt yok sayılır
+typedef struct {
+    float kp;
+    float ki;
+    float kd;
+    float d_cutoff_hz;
+    uint8_t source;
+    uint8_t axis;
+    uint16_t reserved;
+} Pid_Stored_t;
+
+static void Pid_ResetState(void)
+{
+    pid_status.integral = 0.0f;
+    pid_status.d_filt = 0.0f;
+    pid_status.output = 0.0f;
+    pid_status.saturated = 0;
+    has_prev = 0;
+    last_out = INT32_MIN;
+}
+
+/**
+ * @brief Varsayılan kazançlar: Z ekseni hız kontrolü, kontrol kapalı
+ *        Flash'ta geçerli kayıt varsa kazançlar ve kaynak oradan gelir
+ */
+void Pid_Init(void)
+{
+    pid_enabled = 0;
+    pid_config.kp = 0.5f;
+    pid_config.ki = 1.0f;
+    pid_config.kd = 0.0f;
+    pid_config.setpoint = 0.0f;
+    pid_config.source = PID_FB_GYRO_RATE;
+    pid_config.axis = 2;
+    Pid_SetDerivativeCutoff(PID_D_CUTOFF_HZ);
+    Pid_LoadGains();
+    Pid_ResetState();
+}
+
+/**
+ * @brief Saklanan kazançları uygular
+ * @retval HAL_ERROR: kayıt yok veya geçersiz - mevcut kazançlar kalır
+ */
+HAL_StatusTypeDef Pid_LoadGains(void)
+{
+    Pid_Stored_t st;
+
+    if (FlashStore_Load(&st, sizeof(st)) != HAL_OK) return HAL_ERROR;
+    if (st.source >= PID_FB_COUNT || st.axis > 2 || !(st.d_cutoff_hz > 0.0f)) return HAL_ERROR;
+
+    Pid_SetGains(st.kp, st.ki, st.kd);
+    Pid_SetFeedback((Pid_Feedback_t)st.source, st.axis);
+    Pid_SetDerivativeCutoff(st.d_cutoff_hz);
+    return HAL_OK;
+}
+
+/**
+ * @brief Kazançları, türev filtresini ve kaynağı flash'a yazar
+ * Sayfa silme kod okumayı onlarca ms durdurur: motoru zamanlı süren bir kaynak
+ * varken reddedilir, kalan çıkışlar (harita/olay) yazmadan önce serbest bırakılır.
+ * @retval HAL_BUSY: PID, profil, dalga, kuyruk, tanılama, tune veya durma ölçümü aktif
+ */
+HAL_StatusTypeDef Pid_SaveGains(void)
+{
+    Pid_Stored_t st = {0};
+
+    if (pid_enabled || MotorWave_IsActive() || MotorQueue_Depth() > 0 || MotorStop_IsMeasuring() ||
+        MotorIdent_IsRunning() || PidTune_IsRunning()) return HAL_BUSY;
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        if (MotorProfile_IsActive(&motor_channels[i])) return HAL_BUSY;
+    }
+    for (uint8_t i = 0; i < MOTOR_CHANNEL_COUNT; i++)
+    {
+        MotorChannel_WritePulse(&motor_channels[i], 0);
+    }
+
+    st.kp = pid_config.kp;
+    st.ki = pid_config.ki;
+    st.kd = pid_config.kd;
+    st.d_cutoff_hz = pid_config.d_cutoff_hz;
+    st.source = (uint8_t)pid_config.source;
+    st.axis = pid_config.axis;
+    return FlashStore_Save(&st, sizeof(st));
+}
+
+/**
+ * @brief Kontrolü açar/kapatır - açıkken motor sadece PID'den sürülür
+ */
+void Pid_Enable(uint8_t enabled)
+{
+    if (enabled)
+    {
+        MotionEvent_SetMotorEnabled(0);     // Motor tek kaynaktan sürülmeli
+        MotorProfile_Cancel(MOTOR_MAIN);
+        MotorWave_Stop();
+        MotorQueue_Flush();
+    }
+
+    __disable_irq();
+    Pid_ResetState();
+    pid_enabled = enabled;
+    __enable_irq();
+
+    if (!enabled)
+    {
+        HW153_WriteDuty(0, MOTOR_DIRECTION_FORWARD);
+    }
+}
+
+uint8_t Pid_IsEnabled(void)
+{
+    return pid_enabled;
+}
+
+void Pid_SetGains(float kp, float ki, float kd)
+{
+    __disable_irq();
+    pid_config.kp = kp;
+    pid_config.ki = ki;
+    pid_config.kd = kd;
+    __enable_irq();
+}
+
+void Pid_SetSetpoint(float setpoint)
+{
+    pid_config.setpoint = setpoint;
+}
+
+void Pid_SetFeedback(Pid_Feedback_t source, uint8_t axis)
+{
+    __disable_irq();
+    pid_config.source = source;
+    pid_config.axis = axis;
+    Pid_ResetState();               // Farklı birimdeki eski integral/türev geçersiz
+    __enable_irq();
+}
+
+/**
+ * @brief Türev filtresi: birinci derece alçak geçiren, a = 1 - e^(-2π fc dt)
+ */
+void Pid_SetDerivativeCutoff(float hz)
+{
+    float alpha = 1.0f - expf(-2.0f * (float)M_PI * hz * CONTROL_DT_S);
+
+    pid_config.d_cutoff_hz = hz;
+    d_alpha = alpha;
+}
+
+void Pid_SetExternal(float value)
+{
+    sensor_external = value;
+}
+
+/**
+ * @brief Ana döngüden her örnekte çağrılır - ISR'ın okuyacağı son değerler
+ */
+void Pid_UpdateSensors(const L3GD20_Data_t* gyro, const float angle[3])
+{
+    sensor_gyro[0] = gyro->x;
+    sensor_gyro[1] = gyro->y;
+    sensor_gyro[2] = gyro->z;
+    sensor_angle[0] = angle[0];
+    sensor_angle[1] = angle[1];
+    sensor_angle[2] = angle[2];
+}
+
+/**
+ * @brief Geri besleme kaynağının son değeri - PID ve sistem tanıma kaydı için
+ */
+float Pid_ReadFeedback(Pid_Feedback_t source, uint8_t axis)
+{
+    switch (source)
+    {
+    case PID_FB_GYRO_RATE: return sensor_gyro[axis];
+    case PID_FB_ANGLE:     return sensor_angle[axis];
+    case PID_FB_RPM:       return Encoder_GetRpm();
+    default:               return sensor_external;
+    }
+}
+
+/**
+ * @brief Bir PID adımı - kontrol tick'inden (ISR) çağrılır
+ */
+void Pid_Tick(void)
+{
+    if (!pid_enabled) return;
+
+    // Gyro tabanlı kaynakta ölçüm PWM'in etkin olacağı ana ötelenir (telafi kapalıyken 0)
+    float y = Pid_ReadFeedback(pid_config.source, pid_config.axis) +
+              RatePredict_Lead(pid_config.source, pid_config.axis);
+
+    float e = pid_config.setpoint - y;
+
+    // Türev ölçüm üzerinden: setpoint basamağında darbe üretmez
+    float d_raw = has_prev ? -(y - prev_measurement) * (float)CONTROL_TICK_HZ : 0.0f;
+    prev_measurement = y;
+    has_prev = 1;
+    pid_status.d_filt += d_alpha * (d_raw - pid_status.d_filt);
+
+    float integral = pid_status.integral + pid_config.ki * e * CONTROL_DT_S;
+    float u = pid_config.kp * e + integral + pid_config.kd * pid_status.d_filt;
+
+    // Anti-windup: doyumu derinleştiren yönde integrali dondur
+    if (u > PID_OUT_LIMIT)
+    {
+        u = PID_OUT_LIMIT;
+        if (e > 0.0f) integral = pid_status.integral;
+        pid_status.saturated++;
+    }
+    else if (u < -PID_OUT_LIMIT)
+    {
+        u = -PID_OUT_LIMIT;
+        if (e < 0.0f) integral = pid_status.integral;
+        pid_status.saturated++;
+    }
+    if (integral > PID_OUT_LIMIT) integral = PID_OUT_LIMIT;
+    else if (integral < -PID_OUT_LIMIT) integral = -PID_OUT_LIMIT;
+
+    pid_status.measurement = y;
+    pid_status.error = e;
+    pid_status.integral = integral;
+    pid_status.output = u;
+
+    // İşaret = yön, genlik = duty (0.01% adım); register sadece değişince yazılır
+    int32_t out = (int32_t)lroundf(u * (MOTOR_DUTY_FULL / PID_OUT_LIMIT));
+    if (out != last_out)
+    {
+        HW153_WriteDutyFine(out);
+        last_out = out;
+    }
+    RatePredict_MarkOutput();
+}
+
+void Pid_Report(void)
+{
+    char msg[128];
+
+    sprintf(msg, "PID[%s%c SP:%.2f Y:%.2f U:%.1f I:%.2f Kp:%.3f Ki:%.3f Kd:%.4f Sat:%lu]\r\n",
+            pid_source_names[pid_config.source], 'X' + pid_config.axis,
+            pid_config.setpoint, pid_status.measurement, pid_status.output,
+            pid_status.integral, pid_config.kp, pid_config.ki, pid_config.kd,
+            pid_status.saturated);
+    SendDebugMessage(msg);
+}
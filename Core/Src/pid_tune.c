@@ -0,0 +1,269 @@
+#include "pid_tune.h"
+#include "pid.h"
+#include "control.h"
+#include "motor.h"
+#include "motor_profile.h"
+#include "motor_queue.h"
+#include "motor_wave.h"
+#include "motor_ident.h"
+#include "motion_event.h"
+#include "current_sense.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+PidTune_Config_t pid_tune_config;
+volatile PidTune_Status_t pid_tune_status;
+
+static uint32_t tick = 0;
+static uint32_t timeout_ticks = 0;
+static uint32_t last_rise = 0;
+static uint8_t has_rise = 0;
+static uint8_t relay_high = 0;
+static float y_max;
+static float y_min;
+static int32_t last_duty = INT32_MIN;
+
+// Son PID_TUNE_CYCLES çevrim (tick, tepe genliği)
+static uint32_t cycle_ticks[PID_TUNE_CYCLES];
+static float cycle_amp[PID_TUNE_CYCLES];
+
+static volatile uint8_t reported_cycles = 0;
+static volatile uint8_t finished = 0;       // Task kazançları uygulayıp raporlasın
+
+static const char* const rule_names[PID_TUNE_RULE_COUNT] = { "ZN-PID", "ZN-PI", "TL", "SOME-OS", "NO-OS" };
+static const char* const state_names[] = { "IDLE", "RUN", "DONE", "FAIL" };
+static const char* const fail_names[] = { "", "zaman aşımı", "kesildi", "genlik < histerezis" };
+
+// Kp = Ku·kp, Ti = Tu·ti, Td = Tu·td
+static const float rule_table[PID_TUNE_RULE_COUNT][3] = {
+    { 0.6f,        0.5f,        0.125f },
+    { 0.45f,       1.0f / 1.2f, 0.0f },
+    { 1.0f / 2.2f, 2.2f,        1.0f / 6.3f },
+    { 1.0f / 3.0f, 0.5f,        1.0f / 3.0f },
+    { 0.2f,        0.5f,        1.0f / 3.0f },
+};
+
+/**
+ * @brief Varsayılan: ±%20 röle, bias 0, histerezis 1 birim, ZN-PID, 20 s
+ */
+void PidTune_Init(void)
+{
+    pid_tune_config.relay = 20.0f;
+    pid_tune_config.bias = 0.0f;
+    pid_tune_config.hysteresis = 1.0f;
+    pid_tune_config.rule = PID_TUNE_ZN_PID;
+    pid_tune_config.timeout_ms = 20000;
+    memset((void*)&pid_tune_status, 0, sizeof(pid_tune_status));
+    finished = 0;
+}
+
+/**
+ * @brief Röle denemesini başlatır - PID kapatılır, motor röleye geçer
+ * @retval HAL_BUSY: aşırı akım hatası veya deneme sürüyor, HAL_ERROR: geçersiz parametre
+ */
+HAL_StatusTypeDef PidTune_Start(float relay, float bias, float hysteresis,
+                                PidTune_Rule_t rule, uint16_t timeout_ms)
+{
+    if (relay == 0.0f || fabsf(bias) + fabsf(relay) > PID_OUT_LIMIT) return HAL_ERROR;
+    if (hysteresis < 0.0f || rule >= PID_TUNE_RULE_COUNT || timeout_ms == 0) return HAL_ERROR;
+    if (CurrentSense_IsFaulted() || pid_tune_status.state == PID_TUNE_RUNNING) return HAL_BUSY;
+
+    // Motor tek kaynaktan sürülmeli
+    Pid_Enable(0);
+    MotionEvent_SetMotorEnabled(0);
+    MotorProfile_Cancel(MOTOR_MAIN);
+    MotorWave_Stop();
+    MotorQueue_Flush();
+    MotorIdent_Stop();
+
+    __disable_irq();
+    pid_tune_config.relay = relay;
+    pid_tune_config.bias = bias;
+    pid_tune_config.hysteresis = hysteresis;
+    pid_tune_config.rule = rule;
+    pid_tune_config.timeout_ms = timeout_ms;
+
+    memset((void*)&pid_tune_status, 0, sizeof(pid_tune_status));
+    tick = 0;
+    timeout_ticks = (uint32_t)timeout_ms * (CONTROL_TICK_HZ / 1000);
+    has_rise = 0;
+    relay_high = (pid_config.setpoint - Pid_ReadFeedback(pid_config.source, pid_config.axis)) > 0.0f;
+    last_duty = INT32_MIN;
+    reported_cycles = 0;
+    finished = 0;
+    pid_tune_status.state = PID_TUNE_RUNNING;
+    __enable_irq();
+    return HAL_OK;
+}
+
+static void PidTune_Finish(PidTune_State_t state, PidTune_Fail_t fail)
+{
+    HW153_Stop(Motor_GetStopMode());
+    pid_tune_status.fail = fail;
+    pid_tune_status.state = state;
+    finished = 1;
+}
+
+void PidTune_Stop(void)
+{
+    __disable_irq();
+    if (pid_tune_status.state == PID_TUNE_RUNNING) PidTune_Finish(PID_TUNE_FAILED, PID_TUNE_FAIL_ABORTED);
+    __enable_irq();
+}
+
+uint8_t PidTune_IsRunning(void)
+{
+    return pid_tune_status.state == PID_TUNE_RUNNING;
+}
+
+/**
+ * @brief Son çevrimler tutarlıysa Ku/Tu ve kazançları hesaplar
+ * @retval 1: sonuç hazır
+ */
+static uint8_t PidTune_Evaluate(void)
+{
+    uint32_t t_min = UINT32_MAX, t_max = 0, t_sum = 0;
+    float a_min = INFINITY, a_max = 0.0f, a_sum = 0.0f;
+
+    for (uint8_t i = 0; i < PID_TUNE_CYCLES; i++)
+    {
+        if (cycle_ticks[i] < t_min) t_min = cycle_ticks[i];
+        if (cycle_ticks[i] > t_max) t_max = cycle_ticks[i];
+        t_sum += cycle_ticks[i];
+        if (cycle_amp[i] < a_min) a_min = cycle_amp[i];
+        if (cycle_amp[i] > a_max) a_max = cycle_amp[i];
+        a_sum += cycle_amp[i];
+    }
+
+    float t_mean = (float)t_sum / PID_TUNE_CYCLES;
+    float a_mean = a_sum / PID_TUNE_CYCLES;
+    if ((float)(t_max - t_min) > PID_TUNE_TOLERANCE * t_mean) return 0;
+    if (a_max - a_min > PID_TUNE_TOLERANCE * a_mean) return 0;
+
+    // Histerezis düzeltmesi: röle ε'da değil, y = ±ε'da geçer
+    float eps = pid_tune_config.hysteresis;
+    if (a_mean <= eps)
+    {
+        PidTune_Finish(PID_TUNE_FAILED, PID_TUNE_FAIL_AMPLITUDE);
+        return 1;
+    }
+
+    const float* r = rule_table[pid_tune_config.rule];
+    float ku = 4.0f * pid_tune_config.relay / ((float)M_PI * sqrtf(a_mean * a_mean - eps * eps));
+    float tu = t_mean * CONTROL_DT_S;
+    float kp = r[0] * ku;
+
+    pid_tune_status.ku = ku;
+    pid_tune_status.tu = tu;
+    pid_tune_status.kp = kp;
+    pid_tune_status.ki = kp / (r[1] * tu);
+    pid_tune_status.kd = kp * r[2] * tu;
+    PidTune_Finish(PID_TUNE_DONE, PID_TUNE_FAIL_NONE);
+    return 1;
+}
+
+/**
+ * @brief Bir röle adımı - kontrol tick'inden (Encoder_Tick sonrası, Pid_Tick yerine)
+ */
+void PidTune_Tick(void)
+{
+    if (pid_tune_status.state != PID_TUNE_RUNNING) return;
+
+    // Başka kaynak motoru aldıysa deneme geçersiz
+    if (MotorProfile_IsActive(MOTOR_MAIN) || MotorWave_IsActive() || MotorQueue_Depth() > 0 ||
+        Pid_IsEnabled() || CurrentSense_IsFaulted() || MotorIdent_IsRunning())
+    {
+        pid_tune_status.fail = PID_TUNE_FAIL_ABORTED;
+        pid_tune_status.state = PID_TUNE_FAILED;
+        finished = 1;
+        return;
+    }
+
+    float y = Pid_ReadFeedback(pid_config.source, pid_config.axis);
+    float e = pid_config.setpoint - y;
+
+    tick++;
+    if (y > y_max) y_max = y;
+    if (y < y_min) y_min = y;
+
+    if (!relay_high && e > pid_tune_config.hysteresis)
+    {
+        // Yükselen geçiş: önceki geçişten beri bir tam çevrim
+        relay_high = 1;
+        if (has_rise)
+        {
+            uint8_t n = pid_tune_status.cycles;
+            pid_tune_status.period_s = (float)(tick - last_rise) * CONTROL_DT_S;
+            pid_tune_status.amplitude = (y_max - y_min) * 0.5f;
+            if (n >= PID_TUNE_SETTLE_CYCLES)
+            {
+                cycle_ticks[(n - PID_TUNE_SETTLE_CYCLES) % PID_TUNE_CYCLES] = tick - last_rise;
+                cycle_amp[(n - PID_TUNE_SETTLE_CYCLES) % PID_TUNE_CYCLES] = pid_tune_status.amplitude;
+            }
+            if (n < UINT8_MAX) pid_tune_status.cycles = n + 1;
+            if (n + 1 >= PID_TUNE_SETTLE_CYCLES + PID_TUNE_CYCLES && PidTune_Evaluate()) return;
+        }
+        has_rise = 1;
+        last_rise = tick;
+        y_max = y_min = y;
+    }
+    else if (relay_high && e < -pid_tune_config.hysteresis)
+    {
+        relay_high = 0;
+    }
+
+    if (tick >= timeout_ticks)
+    {
+        PidTune_Finish(PID_TUNE_FAILED, PID_TUNE_FAIL_TIMEOUT);
+        return;
+    }
+
+    float u = pid_tune_config.bias + (relay_high ? pid_tune_config.relay : -pid_tune_config.relay);
+    int32_t duty = (int32_t)lroundf(u * (MOTOR_DUTY_FULL / PID_OUT_LIMIT));
+    if (duty != last_duty)
+    {
+        HW153_WriteDutyFine(duty);
+        last_duty = duty;
+    }
+}
+
+/**
+ * @brief Ana döngü - çevrim ilerlemesi, bitince kazançları uygula ve flash'a yaz
+ */
+void PidTune_Task(void)
+{
+    char msg[128];
+
+    if (pid_tune_status.cycles != reported_cycles && pid_tune_status.state == PID_TUNE_RUNNING)
+    {
+        reported_cycles = pid_tune_status.cycles;
+        sprintf(msg, "Tune: çevrim %u/%u Tu:%.3fs a:%.3f\r\n", reported_cycles,
+                PID_TUNE_SETTLE_CYCLES + PID_TUNE_CYCLES, pid_tune_status.period_s, pid_tune_status.amplitude);
+        SendDebugMessage(msg);
+    }
+
+    if (!finished) return;
+    finished = 0;
+
+    if (pid_tune_status.state == PID_TUNE_DONE)
+    {
+        Pid_SetGains(pid_tune_status.kp, pid_tune_status.ki, pid_tune_status.kd);
+        HAL_StatusTypeDef status = Pid_SaveGains();
+        sprintf(msg, "Tune: kazançlar uygulandı, flash %s\r\n", status == HAL_OK ? "OK" : "HATA");
+        SendDebugMessage(msg);
+    }
+    PidTune_Report();
+}
+
+void PidTune_Report(void)
+{
+    char msg[192];
+    const volatile PidTune_Status_t* s = &pid_tune_status;
+
+    sprintf(msg, "Tune[%s%s%s %s d:%.1f%% bias:%.1f%% eps:%.2f n:%u | Ku:%.4f Tu:%.3fs Kp:%.4f Ki:%.4f Kd:%.5f]\r\n",
+            state_names[s->state], s->fail ? " " : "", fail_names[s->fail],
+            rule_names[pid_tune_config.rule], pid_tune_config.relay, pid_tune_config.bias,
+            pid_tune_config.hysteresis, s->cycles, s->ku, s->tu, s->kp, s->ki, s->kd);
+    SendDebugMessage(msg);
+}
@@ -0,0 +1,290 @@
+#include "rate_predict.h"
+#include "timebase.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+RatePredict_Config_t rate_predict_config;
+RatePredict_Result_t rate_predict_result;
+
+// Son örnek - ana döngüde yazılır, kontrol tick'i okur
+static volatile float rate[3];
+static volatile float deriv[3];             // dps/s, filtreli
+static volatile uint32_t sample_ts = 0;
+static volatile uint32_t sample_seq = 0;
+
+static float prev_rate[3];
+static uint32_t prev_ts = 0;
+static uint8_t has_prev = 0;
+
+// Ölçüm kipi
+static volatile uint8_t measuring = 0;
+static volatile uint8_t finished = 0;       // Task raporlasın
+static uint32_t measure_start = 0;
+static uint16_t measure_window = 0;
+static uint8_t measure_axis = 2;
+static uint32_t marked_seq = 0;
+static float pred[RATE_PREDICT_LAGS];       // Örnek başına çıkışa giden tahmin
+static uint32_t pred_seq[RATE_PREDICT_LAGS];
+static float err_sum[RATE_PREDICT_BINS];    // Σ (tahmin_j - y(t_j + k/SUBSTEPS örnek))²
+static uint32_t err_n[RATE_PREDICT_BINS];
+static float lat_sum_ms = 0.0f;
+static float lat_max_ms = 0.0f;
+static uint32_t lat_n = 0;
+static float dt_sum_ms = 0.0f;
+static uint32_t dt_n = 0;
+
+/**
+ * @brief Varsayılan: kapalı, 2 ms ek ufuk (L3GD20 100 Hz bant grup gecikmesi), 20 Hz türev filtresi
+ */
+void RatePredict_Init(void)
+{
+    rate_predict_config.gain = 0.0f;
+    rate_predict_config.horizon_ms = 2.0f;
+    rate_predict_config.d_cutoff_hz = 20.0f;
+    memset(&rate_predict_result, 0, sizeof(rate_predict_result));
+    has_prev = 0;
+    measuring = 0;
+    finished = 0;
+}
+
+/**
+ * @retval HAL_ERROR: geçersiz parametre
+ */
+HAL_StatusTypeDef RatePredict_Configure(float gain, float horizon_ms, float d_cutoff_hz)
+{
+    if (gain < 0.0f || gain > 2.0f || horizon_ms < 0.0f || horizon_ms > 50.0f || d_cutoff_hz <= 0.0f)
+    {
+        return HAL_ERROR;
+    }
+
+    __disable_irq();
+    rate_predict_config.gain = gain;
+    rate_predict_config.horizon_ms = horizon_ms;
+    rate_predict_config.d_cutoff_hz = d_cutoff_hz;
+    __enable_irq();
+    return HAL_OK;
+}
+
+/**
+ * @brief Yeni gyro örneği - örnekleme döngüsünden, Pid_UpdateSensors ile birlikte
+ */
+void RatePredict_Update(const L3GD20_Data_t* gyro)
+{
+    const float v[3] = { gyro->x, gyro->y, gyro->z };
+    float d[3] = { 0.0f, 0.0f, 0.0f };
+    float dt = has_prev ? Timebase_CyclesToSeconds(gyro->timestamp - prev_ts) : 0.0f;
+    float y_prev = prev_rate[measure_axis];
+    uint8_t had_prev = has_prev;
+
+    if (dt > 0.0f)
+    {
+        // Birinci derece alçak geçiren, a = 1 - e^(-2π fc dt), gerçek dt ile
+        float alpha = 1.0f - expf(-2.0f * (float)M_PI * rate_predict_config.d_cutoff_hz * dt);
+        for (int i = 0; i < 3; i++)
+        {
+            d[i] = deriv[i] + alpha * ((v[i] - prev_rate[i]) / dt - deriv[i]);
+        }
+    }
+
+    __disable_irq();
+    for (int i = 0; i < 3; i++)
+    {
+        rate[i] = v[i];
+        deriv[i] = d[i];
+    }
+    sample_ts = gyro->timestamp;
+    sample_seq++;
+    __enable_irq();
+
+    for (int i = 0; i < 3; i++) prev_rate[i] = v[i];
+    prev_ts = gyro->timestamp;
+    has_prev = 1;
+
+    if (!measuring) return;
+
+    // m örnek önceki tahmin, önceki örnekle bu örnek arasındaki ara değerlerle
+    // karşılaştırılır: (m-1, m] örnek kaydırmaları
+    uint32_t seq = sample_seq;
+    for (uint32_t m = 1; had_prev && m < RATE_PREDICT_LAGS; m++)
+    {
+        uint8_t slot = (uint8_t)((seq - m) % RATE_PREDICT_LAGS);
+        if (seq > m && pred_seq[slot] == seq - m)
+        {
+            for (uint32_t s = 1; s <= RATE_PREDICT_SUBSTEPS; s++)
+            {
+                uint32_t k = (m - 1) * RATE_PREDICT_SUBSTEPS + s;
+                float y = y_prev + (v[measure_axis] - y_prev) * (float)s / RATE_PREDICT_SUBSTEPS;
+                float e = pred[slot] - y;
+                err_sum[k] += e * e;
+                err_n[k]++;
+            }
+        }
+    }
+    if (dt > 0.0f)
+    {
+        dt_sum_ms += dt * 1000.0f;
+        dt_n++;
+    }
+
+    if (HAL_GetTick() - measure_start >= measure_window)
+    {
+        measuring = 0;
+        finished = 1;
+    }
+}
+
+/**
+ * @brief Son örnekten PWM'in etkin olacağı ana kadar geçecek süre (s)
+ *        Compare preload'lu: yazılan değer sonraki TIM3 update'inde çıkar
+ */
+static float RatePredict_Age(uint32_t now)
+{
+    uint32_t pwm_wait = (TIM3->ARR - TIM3->CNT) * (TIM3->PSC + 1);
+    return Timebase_CyclesToSeconds(now - sample_ts + pwm_wait);
+}
+
+/**
+ * @brief Geri beslemeye eklenecek öncü - kontrol tick'inden
+ * @retval 0: telafi kapalı veya kaynak gyro tabanlı değil
+ */
+float RatePredict_Lead(Pid_Feedback_t source, uint8_t axis)
+{
+    float gain = rate_predict_config.gain;
+
+    if (gain == 0.0f || sample_seq == 0) return 0.0f;
+
+    float horizon = RatePredict_Age(Timebase_Cycles()) + rate_predict_config.horizon_ms * 0.001f;
+    if (source == PID_FB_GYRO_RATE) return gain * deriv[axis] * horizon;
+    if (source == PID_FB_ANGLE) return gain * rate[axis] * horizon;
+    return 0.0f;
+}
+
+/**
+ * @brief Örnekten türetilen çıkış yazıldı - ölçüm kipinde gecikme ve tahmin kaydı
+ *        Her örnek için sadece ilk çağrı sayılır (PID tick'i veya hız haritası)
+ */
+void RatePredict_MarkOutput(void)
+{
+    if (!measuring || sample_seq == marked_seq) return;
+    marked_seq = sample_seq;
+
+    float age = RatePredict_Age(Timebase_Cycles());
+    float age_ms = age * 1000.0f;
+    lat_sum_ms += age_ms;
+    if (age_ms > lat_max_ms) lat_max_ms = age_ms;
+    lat_n++;
+
+    // Telafi kapalı olsa da yapılandırılmış kazançla tahmin - iki durum aynı koşuda
+    float horizon = age + rate_predict_config.horizon_ms * 0.001f;
+    float p = rate[measure_axis] + rate_predict_config.gain * deriv[measure_axis] * horizon;
+    uint8_t slot = (uint8_t)(marked_seq % RATE_PREDICT_LAGS);
+    pred[slot] = p;
+    pred_seq[slot] = marked_seq;
+
+    float e = p - rate[measure_axis];
+    err_sum[0] += e * e;
+    err_n[0]++;
+}
+
+/**
+ * @brief Gecikme ölçümünü başlatır
+ * @retval HAL_BUSY: ölçüm sürüyor, HAL_ERROR: geçersiz parametre
+ */
+HAL_StatusTypeDef RatePredict_Measure(uint16_t window_ms, uint8_t axis)
+{
+    if (window_ms == 0 || axis > 2) return HAL_ERROR;
+    if (measuring) return HAL_BUSY;
+
+    __disable_irq();
+    memset(pred_seq, 0, sizeof(pred_seq));
+    memset(err_sum, 0, sizeof(err_sum));
+    memset(err_n, 0, sizeof(err_n));
+    lat_sum_ms = 0.0f;
+    lat_max_ms = 0.0f;
+    lat_n = 0;
+    dt_sum_ms = 0.0f;
+    dt_n = 0;
+    marked_seq = sample_seq;
+    measure_axis = axis;
+    measure_window = window_ms;
+    measure_start = HAL_GetTick();
+    finished = 0;
+    measuring = 1;
+    __enable_irq();
+    return HAL_OK;
+}
+
+/**
+ * @brief Ana döngü - biten ölçümü değerlendirir ve raporlar
+ */
+void RatePredict_Task(void)
+{
+    RatePredict_Result_t* r = &rate_predict_result;
+    float mse[RATE_PREDICT_BINS];
+    uint8_t best = 0;
+
+    if (!finished) return;
+    finished = 0;
+
+    for (uint8_t k = 0; k < RATE_PREDICT_BINS; k++)
+    {
+        mse[k] = err_n[k] ? err_sum[k] / (float)err_n[k] : INFINITY;
+        if (mse[k] < mse[best]) best = k;
+    }
+
+    // En iyi kaydırma ve iki komşusundan parabol tepesi; best = 0'da 0..2 kullanılır,
+    // tepe en fazla bir adım dışarı (0'ın altı dahil) taşabilir
+    float lead = (float)best;
+    uint8_t c = (best == 0) ? 1 : (best + 1 < RATE_PREDICT_BINS ? best : best - 1);
+    if (isfinite(mse[c - 1]) && isfinite(mse[c]) && isfinite(mse[c + 1]))
+    {
+        float den = mse[c - 1] - 2.0f * mse[c] + mse[c + 1];
+        if (den > 0.0f)
+        {
+            float vertex = (float)c + 0.5f * (mse[c - 1] - mse[c + 1]) / den;
+            if (vertex < (float)best - 1.0f) vertex = (float)best - 1.0f;
+            else if (vertex > (float)best + 1.0f) vertex = (float)best + 1.0f;
+            lead = vertex;
+        }
+    }
+
+    float dt_ms = dt_n ? dt_sum_ms / (float)dt_n : 0.0f;
+    float step_ms = dt_ms / RATE_PREDICT_SUBSTEPS;
+    r->samples = lat_n;
+    r->raw_ms = lat_n ? lat_sum_ms / (float)lat_n : 0.0f;
+    r->raw_max_ms = lat_max_ms;
+    r->lead_ms = lead * step_ms;
+    r->err_raw = isfinite(mse[0]) ? sqrtf(mse[0]) : 0.0f;
+    r->err_comp = isfinite(mse[best]) ? sqrtf(mse[best]) : 0.0f;
+
+    // Amaçlanan ileri süredeki hata: komşu kaydırmalar arasında doğrusal
+    r->target_ms = r->raw_ms + rate_predict_config.horizon_ms;
+    r->err_target = 0.0f;
+    if (step_ms > 0.0f)
+    {
+        float pos = r->target_ms / step_ms;
+        uint32_t k = (uint32_t)pos;
+        if (k + 1 < RATE_PREDICT_BINS && isfinite(mse[k]) && isfinite(mse[k + 1]))
+        {
+            float frac = pos - (float)k;
+            r->err_target = sqrtf(mse[k] + (mse[k + 1] - mse[k]) * frac);
+        }
+    }
+    r->axis = measure_axis;
+    RatePredict_Report();
+}
+
+void RatePredict_Report(void)
+{
+    char msg[256];
+    const RatePredict_Result_t* r = &rate_predict_result;
+
+    sprintf(msg, "Lat[%s G:%.2f H:%.1fms Fc:%.0fHz | %c n:%lu Ham:%.2f/%.2fms Telafili:%.2fms (öncü %.2fms) "
+            "RMS:%.3f->%.3fdps Hedef %.2fms:%.3fdps]\r\n",
+            measuring ? "..." : (rate_predict_config.gain > 0.0f ? "ON" : "OFF"),
+            rate_predict_config.gain, rate_predict_config.horizon_ms, rate_predict_config.d_cutoff_hz,
+            'X' + r->axis, r->samples, r->raw_ms, r->raw_max_ms,
+            r->raw_ms - r->lead_ms, r->lead_ms, r->err_raw, r->err_comp, r->target_ms, r->err_target);
+    SendDebugMessage(msg);
+}
@@ -0,0 +1,195 @@
+#include "sample_sync.h"
+#include "timebase.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+SampleSync_Config_t sample_sync_config;
+SampleSync_Stats_t sample_sync_stats;
+
+// Gürültü kipi - 0: asenkron, 1: senkron
+static SampleSync_Noise_t noise[2];
+static uint8_t noise_active = 0;
+static uint8_t noise_done = 0;
+static uint8_t noise_group = 0;             // Son Wait'in grubu
+static uint32_t noise_start = 0;
+static uint16_t noise_window = 0;
+static SampleSync_Mode_t noise_sync_mode = SAMPLE_SYNC_ON;
+
+static const char* const mode_names[SAMPLE_SYNC_MODE_COUNT] = { "OFF", "ON", "PHASE" };
+
+void SampleSync_Init(void)
+{
+    sample_sync_config.mode = SAMPLE_SYNC_OFF;
+    sample_sync_config.phase_pct = 50;
+    memset(&sample_sync_stats, 0, sizeof(sample_sync_stats));
+    noise_active = 0;
+    noise_done = 0;
+}
+
+/**
+ * @brief Bir PWM periyodu bekleme sınırına sığıyor mu - sığmazsa her faz ulaşılamaz
+ */
+static uint8_t SampleSync_PeriodFits(void)
+{
+    uint32_t period_cycles = (TIM3->ARR + 1) * (TIM3->PSC + 1);
+    return period_cycles <= SAMPLE_SYNC_MAX_WAIT_US * (SystemCoreClock / 1000000U);
+}
+
+/**
+ * @retval HAL_ERROR: geçersiz kip veya faz, ya da PWM periyodu bekleme sınırından uzun
+ */
+HAL_StatusTypeDef SampleSync_Configure(SampleSync_Mode_t mode, uint8_t phase_pct)
+{
+    if (mode >= SAMPLE_SYNC_MODE_COUNT || phase_pct > 99) return HAL_ERROR;
+    if (mode != SAMPLE_SYNC_OFF && !SampleSync_PeriodFits()) return HAL_ERROR;
+
+    sample_sync_config.mode = mode;
+    sample_sync_config.phase_pct = phase_pct;
+    memset(&sample_sync_stats, 0, sizeof(sample_sync_stats));
+    return HAL_OK;
+}
+
+/**
+ * @brief Seçilen faza kadar bekler - kalan süre sayaçtan hesaplanır
+ * @retval 1: hedef SAMPLE_SYNC_MAX_WAIT_US'den uzak, beklenmedi
+ */
+static uint8_t SampleSync_WaitPhase(SampleSync_Mode_t mode)
+{
+    uint32_t period = TIM3->ARR + 1;
+    uint32_t target = (mode == SAMPLE_SYNC_ON) ? TIM3->CCR4 % period
+                                               : period * sample_sync_config.phase_pct / 100U;
+    uint32_t start = Timebase_Cycles();
+    uint32_t cnt = TIM3->CNT;
+
+    // Timer saati çekirdek saatine eşit: sayım x (PSC+1) = cycle
+    uint32_t remaining = ((target + period - cnt) % period) * (TIM3->PSC + 1);
+    if (remaining > SAMPLE_SYNC_MAX_WAIT_US * (SystemCoreClock / 1000000U)) return 1;
+
+    while (Timebase_Cycles() - start < remaining)
+    {
+    }
+    return 0;
+}
+
+/**
+ * @brief Örnek okumasından hemen önce çağrılır (ana döngü)
+ *        Gürültü kipinde senkron ve asenkron sırayla uygulanır
+ */
+void SampleSync_Wait(void)
+{
+    SampleSync_Mode_t mode = sample_sync_config.mode;
+
+    if (noise_active)
+    {
+        noise_group ^= 1;
+        mode = noise_group ? noise_sync_mode : SAMPLE_SYNC_OFF;
+    }
+    if (mode == SAMPLE_SYNC_OFF) return;
+
+    uint32_t start = Timebase_Cycles();
+    uint8_t skipped = SampleSync_WaitPhase(mode);
+    uint32_t waited = Timebase_Cycles() - start;
+
+    sample_sync_stats.waits++;
+    sample_sync_stats.wait_sum_cycles += waited;
+    if (waited > sample_sync_stats.wait_max_cycles) sample_sync_stats.wait_max_cycles = waited;
+    if (skipped)
+    {
+        // Beklenmeden okundu = asenkron: gürültü kipinde senkron grubu kirletmesin
+        sample_sync_stats.skipped++;
+        noise_group = 0;
+    }
+}
+
+/**
+ * @brief Gürültü karşılaştırmasını başlatır - kart hareketsiz, motor dönerken
+ *        Senkron grup seçili kipi, kip OFF ise iletim ortasını kullanır
+ * @retval HAL_BUSY: ölçüm sürüyor, HAL_ERROR: geçersiz süre veya PWM periyodu bekleme sınırından uzun
+ */
+HAL_StatusTypeDef SampleSync_NoiseStart(uint16_t window_ms)
+{
+    if (window_ms == 0 || !SampleSync_PeriodFits()) return HAL_ERROR;
+    if (noise_active) return HAL_BUSY;
+
+    memset(noise, 0, sizeof(noise));
+    noise_sync_mode = (sample_sync_config.mode == SAMPLE_SYNC_OFF) ? SAMPLE_SYNC_ON : sample_sync_config.mode;
+    noise_group = 0;
+    noise_window = window_ms;
+    noise_start = HAL_GetTick();
+    noise_done = 0;
+    noise_active = 1;
+    return HAL_OK;
+}
+
+/**
+ * @brief Okunan örneği Wait'in grubuna ekler (Welford)
+ */
+void SampleSync_NoiseSample(const L3GD20_Data_t* gyro, const float acc[3], uint8_t acc_ok)
+{
+    if (!noise_active) return;
+
+    SampleSync_Noise_t* g = &noise[noise_group];
+    const float v[6] = { gyro->x, gyro->y, gyro->z, acc[0], acc[1], acc[2] };
+    uint8_t channels = acc_ok ? 6 : 3;
+
+    // İvme kanalları kendi sayacıyla - okuma başarısızsa ortalama/varyans bozulmasın
+    g->n++;
+    if (acc_ok) g->n_acc++;
+    for (uint8_t i = 0; i < channels; i++)
+    {
+        float d = v[i] - g->mean[i];
+        g->mean[i] += d / (float)((i < 3) ? g->n : g->n_acc);
+        g->m2[i] += d * (v[i] - g->mean[i]);
+    }
+
+    if (HAL_GetTick() - noise_start >= noise_window)
+    {
+        noise_active = 0;
+        noise_done = 1;
+    }
+}
+
+/**
+ * @brief Ana döngü - biten gürültü ölçümünü raporlar
+ */
+void SampleSync_Task(void)
+{
+    char msg[160];
+    char acc_text[48];
+    static const char* const group_names[2] = { "ASYNC", "SYNC" };
+
+    if (!noise_done) return;
+    noise_done = 0;
+
+    for (uint8_t k = 0; k < 2; k++)
+    {
+        const SampleSync_Noise_t* g = &noise[k];
+        float rms[6];
+
+        for (uint8_t i = 0; i < 6; i++)
+        {
+            uint32_t n = (i < 3) ? g->n : g->n_acc;
+            rms[i] = (n > 1) ? sqrtf(g->m2[i] / (float)(n - 1)) : 0.0f;
+        }
+        if (g->n_acc > 1) sprintf(acc_text, "%.4f/%.4f/%.4fg n:%lu", rms[3], rms[4], rms[5], g->n_acc);
+        else sprintf(acc_text, "n/a");
+        sprintf(msg, "Noise[%s%s n:%lu G:%.4f/%.4f/%.4fdps A:%s]\r\n",
+                group_names[k], k ? (noise_sync_mode == SAMPLE_SYNC_ON ? "-ON" : "-PHASE") : "",
+                g->n, rms[0], rms[1], rms[2], acc_text);
+        SendDebugMessage(msg);
+    }
+}
+
+void SampleSync_Report(void)
+{
+    char msg[128];
+    const SampleSync_Stats_t* s = &sample_sync_stats;
+
+    sprintf(msg, "Sync[%s %u%% | Bekleme:%lu ort:%.1fus max:%.1fus Atlanan:%lu%s]\r\n",
+            mode_names[sample_sync_config.mode], sample_sync_config.phase_pct, s->waits,
+            s->waits ? (float)s->wait_sum_cycles * 1e6f / (float)SystemCoreClock / (float)s->waits : 0.0f,
+            (float)s->wait_max_cycles * 1e6f / (float)SystemCoreClock, s->skipped,
+            noise_active ? " | gürültü ölçülüyor" : "");
+    SendDebugMessage(msg);
+}
@@ -0,0 +1,362 @@
+#include "spectrum.h"
+#include "timebase.h"
+#include <math.h>
+#include <stdio.h>
+
+#if (SPECTRUM_N != 256) && (SPECTRUM_N != 512)
+#error "SPECTRUM_N 256 veya 512 olmalı"
+#endif
+
+Spectrum_Result_t spectrum_result;
+
+typedef enum {
+    SPECTRUM_IDLE = 0,
+    SPECTRUM_LOAD,      // Ortalama çıkar + Hann + bit-reversal
+    SPECTRUM_PASS,      // Bir radix-2 / radix-4 geçişi
+    SPECTRUM_SPLIT,     // N/2 kompleks -> N gerçek spektrum (güç)
+    SPECTRUM_ANALYZE    // Tepe ve bant enerjileri
+} Spectrum_Step_t;
+
+static const float band_edges_hz[SPECTRUM_BANDS + 1] = SPECTRUM_BAND_EDGES_HZ;
+
+// Yakalama tamponu (ana döngü örnekleme adımı doldurur)
+static float capture[SPECTRUM_N];
+static float capture_sum;
+static uint32_t capture_ts_first;
+static uint32_t capture_ts_last;
+static uint16_t capture_len;
+
+// Hesap tamponları
+static float frame[SPECTRUM_N];             // Hesaplanan çerçevenin kopyası
+static float frame_mean;
+static uint32_t frame_cycles;               // Çerçevenin örnek aralığı (cycle)
+static float work[2 * SPECTRUM_M];          // Kompleks (re, im) sıralı
+static float power[SPECTRUM_M];             // |X[k]|², k = 0..N/2-1
+static float twiddle[2 * SPECTRUM_M];       // W_N^k = cos - i·sin, k = 0..N/2-1
+static float window_sum;
+static float window_sq_sum;
+static uint16_t bitrev[SPECTRUM_M];
+
+static Spectrum_Axis_t spectrum_axis = SPECTRUM_AXIS_Z;
+static Spectrum_Step_t spectrum_step = SPECTRUM_IDLE;
+static uint16_t pass_span;                  // Radix-4 geçişinin L değeri
+static uint32_t cycles_frame;
+static uint32_t cycles_step_max;
+
+/* Periyodik Hann penceresi: 0.5 - 0.5·cos(2πn/N); cos tablodan (simetri ile) */
+static inline float Spectrum_Window(uint16_t n)
+{
+    float c;
+    if (n < SPECTRUM_M) c = twiddle[2 * n];
+    else if (n == SPECTRUM_M) c = -1.0f;
+    else c = twiddle[2 * (SPECTRUM_N - n)];
+    return 0.5f - 0.5f * c;
+}
+
+/**
+ * @brief Twiddle, bit-reversal ve pencere sabitlerini hazırlar
+ */
+void Spectrum_Init(void)
+{
+    uint16_t bits = 0;
+    while ((1U << bits) < SPECTRUM_M) bits++;
+
+    for (uint16_t k = 0; k < SPECTRUM_M; k++)
+    {
+        float phase = 2.0f * (float)M_PI * (float)k / (float)SPECTRUM_N;
+        twiddle[2 * k] = cosf(phase);
+        twiddle[2 * k + 1] = -sinf(phase);
+
+        uint16_t r = 0;
+        for (uint16_t b = 0; b < bits; b++)
+        {
+            if (k & (1U << b)) r |= (uint16_t)(1U << (bits - 1 - b));
+        }
+        bitrev[k] = r;
+    }
+
+    window_sum = 0.0f;
+    window_sq_sum = 0.0f;
+    for (uint16_t n = 0; n < SPECTRUM_N; n++)
+    {
+        float w = Spectrum_Window(n);
+        window_sum += w;
+        window_sq_sum += w * w;
+    }
+
+    memset(&spectrum_result, 0, sizeof(spectrum_result));
+    capture_len = 0;
+    capture_sum = 0.0f;
+    spectrum_step = SPECTRUM_IDLE;
+}
+
+/**
+ * @brief Analiz edilen ekseni seçer (FFTAX komutu) - yakalama baştan başlar
+ */
+void Spectrum_SetAxis(Spectrum_Axis_t axis)
+{
+    if (axis > SPECTRUM_AXIS_Z) return;
+    spectrum_axis = axis;
+    capture_len = 0;
+    capture_sum = 0.0f;
+}
+
+/**
+ * @brief Örnekleme adımından çağrılır - tampon dolunca hesap başlatılır
+ */
+void Spectrum_AddSample(const L3GD20_Data_t* data)
+{
+    float v = (spectrum_axis == SPECTRUM_AXIS_X) ? data->x :
+              (spectrum_axis == SPECTRUM_AXIS_Y) ? data->y : data->z;
+
+    if (capture_len == 0) capture_ts_first = data->timestamp;
+    capture[capture_len++] = v;
+    capture_sum += v;
+    capture_ts_last = data->timestamp;
+
+    if (capture_len < SPECTRUM_N) return;
+
+    if (spectrum_step == SPECTRUM_IDLE)
+    {
+        memcpy(frame, capture, sizeof(frame));
+        frame_mean = capture_sum / (float)SPECTRUM_N;
+        frame_cycles = capture_ts_last - capture_ts_first;
+        cycles_frame = 0;
+        cycles_step_max = 0;
+        spectrum_step = SPECTRUM_LOAD;
+    }
+    else
+    {
+        spectrum_result.overruns++;
+    }
+    capture_len = 0;
+    capture_sum = 0.0f;
+}
+
+static void Spectrum_Load(void)
+{
+    // z[m] = x[2m] + i·x[2m+1], bit-reversed sıraya yazılır
+    for (uint16_t n = 0; n < SPECTRUM_N; n++)
+    {
+        work[2 * bitrev[n >> 1] + (n & 1)] = (frame[n] - frame_mean) * Spectrum_Window(n);
+    }
+}
+
+static void Spectrum_Radix2Pass(void)
+{
+    for (uint16_t k = 0; k < 2 * SPECTRUM_M; k += 4)
+    {
+        float ar = work[k], ai = work[k + 1];
+        float br = work[k + 2], bi = work[k + 3];
+        work[k] = ar + br;
+        work[k + 1] = ai + bi;
+        work[k + 2] = ar - br;
+        work[k + 3] = ai - bi;
+    }
+}
+
+/* İki ardışık radix-2 DIT aşamasını (2L ve 4L) tek radix-4 kelebekte birleştirir */
+static void Spectrum_Radix4Pass(uint16_t L)
+{
+    uint16_t tw_step = SPECTRUM_N / (4 * L);     // W_4L^j = W_N^(j·N/4L)
+
+    for (uint16_t j = 0; j < L; j++)
+    {
+        float w1r = twiddle[2 * (j * tw_step)];
+        float w1i = twiddle[2 * (j * tw_step) + 1];
+        float w2r = twiddle[2 * (2 * j * tw_step)];
+        float w2i = twiddle[2 * (2 * j * tw_step) + 1];
+
+        for (uint16_t k = j; k < SPECTRUM_M; k += 4 * L)
+        {
+            float* a = &work[2 * k];
+            float* b = &work[2 * (k + L)];
+            float* c = &work[2 * (k + 2 * L)];
+            float* d = &work[2 * (k + 3 * L)];
+
+            // Aşama 2L: (a,b) ve (c,d) - W_2L^j = W_4L^2j
+            float tbr = w2r * b[0] - w2i * b[1];
+            float tbi = w2r * b[1] + w2i * b[0];
+            float tdr = w2r * d[0] - w2i * d[1];
+            float tdi = w2r * d[1] + w2i * d[0];
+            float a1r = a[0] + tbr, a1i = a[1] + tbi;
+            float b1r = a[0] - tbr, b1i = a[1] - tbi;
+            float c1r = c[0] + tdr, c1i = c[1] + tdi;
+            float d1r = c[0] - tdr, d1i = c[1] - tdi;
+
+            // Aşama 4L: (a1,c1) W_4L^j, (b1,d1) W_4L^(j+L) = -i·W_4L^j
+            float tcr = w1r * c1r - w1i * c1i;
+            float tci = w1r * c1i + w1i * c1r;
+            float ter = w1r * d1i + w1i * d1r;      // -i·(w1·d1) reel
+            float tei = -(w1r * d1r - w1i * d1i);   // -i·(w1·d1) sanal
+
+            a[0] = a1r + tcr;  a[1] = a1i + tci;
+            c[0] = a1r - tcr;  c[1] = a1i - tci;
+            b[0] = b1r + ter;  b[1] = b1i + tei;
+            d[0] = b1r - ter;  d[1] = b1i - tei;
+        }
+    }
+}
+
+static void Spectrum_Split(void)
+{
+    float x0 = work[0] + work[1];
+    power[0] = x0 * x0;
+
+    for (uint16_t k = 1; k < SPECTRUM_M; k++)
+    {
+        float zr = work[2 * k], zi = work[2 * k + 1];
+        float mr = work[2 * (SPECTRUM_M - k)], mi = work[2 * (SPECTRUM_M - k) + 1];
+
+        // Xe = (Z[k] + conj(Z[M-k]))/2,  Xo = -i·(Z[k] - conj(Z[M-k]))/2
+        float er = 0.5f * (zr + mr), ei = 0.5f * (zi - mi);
+        float or_ = 0.5f * (zi + mi), oi = -0.5f * (zr - mr);
+
+        // X[k] = Xe + W_N^k · Xo
+        float wr = twiddle[2 * k], wi = twiddle[2 * k + 1];
+        float xr = er + wr * or_ - wi * oi;
+        float xi = ei + wr * oi + wi * or_;
+        power[k] = xr * xr + xi * xi;
+    }
+}
+
+static void Spectrum_Analyze(void)
+{
+    Spectrum_Result_t* r = &spectrum_result;
+    float fs = (frame_cycles > 0)
+             ? (float)(SPECTRUM_N - 1) * (float)SystemCoreClock / (float)frame_cycles
+             : 0.0f;
+    float bin_hz = fs / (float)SPECTRUM_N;
+    float amp_scale = 2.0f / window_sum;
+    float pwr_scale = 2.0f / ((float)SPECTRUM_N * window_sq_sum);
+    float top[SPECTRUM_PEAKS] = {0};
+
+    r->fs_hz = fs;
+    for (int p = 0; p < SPECTRUM_PEAKS; p++)
+    {
+        r->peak_hz[p] = 0.0f;
+        r->peak_amp[p] = 0.0f;
+    }
+
+    // Yerel maksimumlar - parabolik interpolasyonla frekans
+    for (uint16_t k = 1; k < SPECTRUM_M - 1; k++)
+    {
+        float p = power[k];
+        if (p <= power[k - 1] || p < power[k + 1] || p <= top[SPECTRUM_PEAKS - 1]) continue;
+
+        float den = power[k - 1] - 2.0f * p + power[k + 1];
+        float delta = (den != 0.0f) ? 0.5f * (power[k - 1] - power[k + 1]) / den : 0.0f;
+
+        int pos = SPECTRUM_PEAKS - 1;
+        while (pos > 0 && p > top[pos - 1])
+        {
+            top[pos] = top[pos - 1];
+            r->peak_hz[pos] = r->peak_hz[pos - 1];
+            r->peak_amp[pos] = r->peak_amp[pos - 1];
+            pos--;
+        }
+        top[pos] = p;
+        r->peak_hz[pos] = ((float)k + delta) * bin_hz;
+        r->peak_amp[pos] = sqrtf(p) * amp_scale;
+    }
+
+    // Bant enerjileri
+    for (int b = 0; b < SPECTRUM_BANDS; b++)
+    {
+        float sum = 0.0f;
+        for (uint16_t k = 1; k < SPECTRUM_M; k++)
+        {
+            float f = (float)k * bin_hz;
+            if (f >= band_edges_hz[b] && f < band_edges_hz[b + 1]) sum += power[k];
+        }
+        r->band_power[b] = sum * pwr_scale;
+    }
+}
+
+/**
+ * @brief Ana döngüden her turda çağrılır - bekleyen hesabın bir adımını yapar
+ */
+void Spectrum_Task(void)
+{
+    uint32_t t0;
+
+    if (spectrum_step == SPECTRUM_IDLE) return;
+
+    t0 = Timebase_Cycles();
+    switch (spectrum_step)
+    {
+    case SPECTRUM_LOAD:
+        Spectrum_Load();
+        // log2(M) tekse ilk geçiş radix-2, sonra radix-4'ler
+        if ((31 - __builtin_clz(SPECTRUM_M)) & 1)
+        {
+            Spectrum_Radix2Pass();
+            pass_span = 2;
+        }
+        else
+        {
+            pass_span = 1;
+        }
+        spectrum_step = SPECTRUM_PASS;
+        break;
+
+    case SPECTRUM_PASS:
+        Spectrum_Radix4Pass(pass_span);
+        pass_span *= 4;
+        if (pass_span >= SPECTRUM_M) spectrum_step = SPECTRUM_SPLIT;
+        break;
+
+    case SPECTRUM_SPLIT:
+        Spectrum_Split();
+        spectrum_step = SPECTRUM_ANALYZE;
+        break;
+
+    case SPECTRUM_ANALYZE:
+        Spectrum_Analyze();
+        spectrum_step = SPECTRUM_IDLE;
+        break;
+
+    default:
+        spectrum_step = SPECTRUM_IDLE;
+        break;
+    }
+
+    uint32_t dt = Timebase_Cycles() - t0;
+    cycles_frame += dt;
+    if (dt > cycles_step_max) cycles_step_max = dt;
+
+    if (spectrum_step == SPECTRUM_IDLE)
+    {
+        spectrum_result.cycles_total = cycles_frame;
+        spectrum_result.cycles_max_step = cycles_step_max;
+        spectrum_result.frames++;
+    }
+}
+
+/**
+ * @brief Son spektrum sonucunu UART'a yazar (yeni çerçeve varsa)
+ */
+void Spectrum_Report(void)
+{
+    static uint32_t reported_frames = 0;
+    char msg[224];
+    int len;
+    Spectrum_Result_t* r = &spectrum_result;
+
+    if (r->frames == reported_frames) return;
+    reported_frames = r->frames;
+
+    len = sprintf(msg, "Spectrum[fs:%.1f Pk:", r->fs_hz);
+    for (int p = 0; p < SPECTRUM_PEAKS; p++)
+    {
+        len += sprintf(&msg[len], "%s%.1fHz/%.2f", p ? "," : "", r->peak_hz[p], r->peak_amp[p]);
+    }
+    len += sprintf(&msg[len], " Band:");
+    for (int b = 0; b < SPECTRUM_BANDS; b++)
+    {
+        len += sprintf(&msg[len], "%s%.3f", b ? "," : "", r->band_power[b]);
+    }
+    sprintf(&msg[len], " Cyc:%lu Max:%lu Ovr:%lu]\r\n",
+            r->cycles_total, r->cycles_max_step, r->overruns);
+    SendDebugMessage(msg);
+}
@@ -0,0 +1,202 @@
+#include "speed_profile.h"
+#include <math.h>
+#include <string.h>
+
+#define Q32     4294967296.0
+
+static int64_t SpeedProfile_ToQ32(double value)
+{
+    return (int64_t)(value * Q32 + (value >= 0.0 ? 0.5 : -0.5));
+}
+
+static uint32_t SpeedProfile_CeilTicks(float seconds, float tick_hz)
+{
+    float ticks = seconds * tick_hz - 1e-4f;   // Yuvarlama artığı bir tick eklemesin
+    return (ticks > 0.0f) ? (uint32_t)ceilf(ticks) : 0;
+}
+
+/**
+ * @brief v0 -> v1 geçişini 3 faza böler (jerk, sabit ivme, jerk)
+ * Süreler tam tick'e yukarı yuvarlanır ve tepe ivme/jerk buna göre küçültülür;
+ * böylece sınırlar aşılmaz ve geçiş tam v1'de biter.
+ */
+static void SpeedProfile_PlanTransition(SpeedProfile_Plan_t* plan, uint8_t base, float v0, float v1,
+                                        const SpeedProfile_Params_t* params, float tick_hz)
+{
+    float dv = fabsf(v1 - v0);
+    float sign = (v1 < v0) ? -1.0f : 1.0f;
+    uint32_t nj = 0, na = 0;
+    double ap = 0.0, jk = 0.0;
+
+    if (dv > 0.0f)
+    {
+        if (params->jerk > 0.0f)
+        {
+            float tj = params->accel / params->jerk;
+            float ta = 0.0f;
+            if (dv >= params->accel * tj) ta = dv / params->accel - tj;
+            else tj = sqrtf(dv / params->jerk);     // Tepe ivmeye ulaşılmıyor
+            nj = SpeedProfile_CeilTicks(tj, tick_hz);
+            na = SpeedProfile_CeilTicks(ta, tick_hz);
+        }
+        else
+        {
+            na = SpeedProfile_CeilTicks(dv / params->accel, tick_hz);
+        }
+        if (nj == 0 && na == 0) na = 1;
+
+        // Tick birimleri: ivme birim/tick, jerk birim/tick²
+        ap = (double)dv / (double)(nj + na);
+        jk = (nj > 0) ? ap / (double)nj : 0.0;
+    }
+
+    plan->ticks[base] = nj;
+    plan->ticks[base + 1] = na;
+    plan->ticks[base + 2] = nj;
+
+    plan->vel_q[base] = SpeedProfile_ToQ32(v0);
+    plan->accel_q[base] = 0;
+    plan->jerk_q[base] = SpeedProfile_ToQ32(sign * jk);
+
+    plan->vel_q[base + 1] = SpeedProfile_ToQ32(v0 + sign * ap * nj / 2.0);
+    plan->accel_q[base + 1] = SpeedProfile_ToQ32(sign * ap);
+    plan->jerk_q[base + 1] = 0;
+
+    plan->vel_q[base + 2] = SpeedProfile_ToQ32(v0 + sign * ap * (nj / 2.0 + na));
+    plan->accel_q[base + 2] = SpeedProfile_ToQ32(sign * ap);
+    plan->jerk_q[base + 2] = SpeedProfile_ToQ32(-sign * jk);
+}
+
+/**
+ * @brief Profili planlar (bölme ve kök burada, ISR'da değil)
+ * @retval 0: başarılı, -1: geçersiz parametre
+ */
+int SpeedProfile_Plan(SpeedProfile_Plan_t* plan, const SpeedProfile_Params_t* params, float tick_hz)
+{
+    if (params->accel <= 0.0f || params->jerk < 0.0f || params->cruise_s < 0.0f || tick_hz <= 0.0f)
+    {
+        return -1;
+    }
+
+    memset(plan, 0, sizeof(*plan));
+    plan->tick_hz = tick_hz;
+
+    SpeedProfile_PlanTransition(plan, 0, params->v_start, params->v_peak, params, tick_hz);
+
+    plan->ticks[3] = (uint32_t)(params->cruise_s * tick_hz + 0.5f);
+    plan->vel_q[3] = SpeedProfile_ToQ32(params->v_peak);
+
+    SpeedProfile_PlanTransition(plan, 4, params->v_peak, params->v_end, params, tick_hz);
+
+    plan->v_end = (int32_t)lroundf(params->v_end);
+    for (uint8_t i = 0; i < SPEED_PROFILE_PHASES; i++)
+    {
+        plan->total_ticks += plan->ticks[i];
+    }
+    return 0;
+}
+
+void SpeedProfile_Begin(SpeedProfile_State_t* state, const SpeedProfile_Plan_t* plan)
+{
+    state->plan = plan;
+    state->phase = 0;
+    state->tick = 0;
+    state->v_q = plan->vel_q[0];
+    state->a_q = plan->accel_q[0];
+}
+
+/**
+ * @brief Bir tick ilerlet - sadece toplama ve kaydırma
+ * Sabit jerk altında v += a + j/2, a += j tam (ayrık) integraldir; faz
+ * başlarında değerler planlanan değerlere eşitlenir, hata birikmez.
+ * @retval 1: profil devam ediyor, 0: bitti (*out = v_end)
+ */
+uint8_t SpeedProfile_Step(SpeedProfile_State_t* state, int32_t* out)
+{
+    const SpeedProfile_Plan_t* plan = state->plan;
+
+    while (state->phase < SPEED_PROFILE_PHASES && state->tick >= plan->ticks[state->phase])
+    {
+        state->phase++;
+        state->tick = 0;
+        if (state->phase < SPEED_PROFILE_PHASES)
+        {
+            state->v_q = plan->vel_q[state->phase];
+            state->a_q = plan->accel_q[state->phase];
+        }
+    }
+
+    if (state->phase >= SPEED_PROFILE_PHASES)
+    {
+        *out = plan->v_end;
+        return 0;
+    }
+
+    int64_t jerk = plan->jerk_q[state->phase];
+    state->v_q += state->a_q + (jerk >> 1);
+    state->a_q += jerk;
+    state->tick++;
+
+    *out = (int32_t)((state->v_q + ((int64_t)1 << 31)) >> 32);
+    return 1;
+}
+
+/**
+ * @brief v0 -> v1 geçişinin süresi ve t anındaki değeri (sürekli zaman)
+ */
+static double SpeedProfile_RefTransition(double v0, double v1, double accel, double jerk, double t, double* duration)
+{
+    double dv = fabs(v1 - v0);
+    double sign = (v1 < v0) ? -1.0 : 1.0;
+
+    if (dv == 0.0)
+    {
+        *duration = 0.0;
+        return v1;
+    }
+
+    if (jerk <= 0.0)
+    {
+        // Trapez: sabit ivme
+        *duration = dv / accel;
+        return (t >= *duration) ? v1 : v0 + sign * accel * t;
+    }
+
+    double tj = accel / jerk;
+    double ta = 0.0;
+    if (dv >= accel * tj) ta = dv / accel - tj;
+    else tj = sqrt(dv / jerk);      // Tepe ivmeye ulaşılmıyor
+    double ap = jerk * tj;
+
+    *duration = 2.0 * tj + ta;
+    if (t >= *duration) return v1;
+    if (t < tj) return v0 + sign * jerk * t * t / 2.0;
+    if (t < tj + ta) return v0 + sign * (ap * tj / 2.0 + ap * (t - tj));
+    double r = *duration - t;
+    return v1 - sign * jerk * r * r / 2.0;
+}
+
+/**
+ * @brief Bağımsız referans: t saniyedeki değer, parametrelerden kapalı formla
+ * Plan tablolarını kullanmaz; plan süreleri tam tick'e yuvarladığı için
+ * fark faz başına en fazla bir tick'lik kaymadır.
+ */
+float SpeedProfile_Reference(const SpeedProfile_Params_t* params, float t)
+{
+    double up, down;
+    double v = SpeedProfile_RefTransition(params->v_start, params->v_peak, params->accel, params->jerk, t, &up);
+
+    if (t < up) return (float)v;
+    t -= (float)up;
+    if (t < params->cruise_s) return params->v_peak;
+    t -= params->cruise_s;
+    return (float)SpeedProfile_RefTransition(params->v_peak, params->v_end, params->accel, params->jerk, t, &down);
+}
+
+/**
+ * @brief Beklenen tamamlanma süresi (s)
+ */
+float SpeedProfile_Duration(const SpeedProfile_Plan_t* plan)
+{
+    return (float)plan->total_ticks / plan->tick_hz;
+}
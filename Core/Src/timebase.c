@@ -0,0 +1,27 @@
+#include "timebase.h"
+
+/**
+ * @brief DWT cycle counter'ı etkinleştirir
+ */
+void Timebase_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Cycle farkını saniyeye çevirir
+ */
+float Timebase_CyclesToSeconds(uint32_t cycles)
+{
+    return (float)cycles / (float)SystemCoreClock;
+}
+
+/**
+ * @brief Cycle farkını mikrosaniyeye çevirir
+ */
+uint32_t Timebase_CyclesToUs(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000U);
+}
@@ -0,0 +1,170 @@
+#include "uart_tx.h"
+#include "usart.h"
+#include <stdio.h>
+#include <string.h>
+
+UartTx_Stats_t uart_tx_stats;
+
+// head: yazma, tail: DMA'nın okuduğu - serbest sayan indeksler, fark = doluluk
+static uint8_t tx_buf[UART_TX_BUF_SIZE];
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+static volatile uint16_t dma_len = 0;       // Süren aktarımın uzunluğu
+static volatile uint8_t busy = 0;
+
+void UartTx_Init(void)
+{
+    head = 0;
+    tail = 0;
+    dma_len = 0;
+    busy = 0;
+    memset(&uart_tx_stats, 0, sizeof(uart_tx_stats));
+}
+
+/**
+ * @brief Tampondaki ilk bitişik parçayı DMA'ya verir
+ *        Kesmeler kapalıyken veya TX tamamlanma kesmesinden çağrılır
+ */
+static void UartTx_Kick(void)
+{
+    if (busy || head == tail) return;
+
+    uint32_t start = tail & (UART_TX_BUF_SIZE - 1);
+    uint32_t len = head - tail;
+    if (len > UART_TX_BUF_SIZE - start) len = UART_TX_BUF_SIZE - start;   // Sarmada ikiye bölünür
+
+    dma_len = (uint16_t)len;
+    busy = 1;
+    if (HAL_UART_Transmit_DMA(&huart2, &tx_buf[start], (uint16_t)len) != HAL_OK)
+    {
+        busy = 0;
+        uart_tx_stats.errors++;
+        return;
+    }
+    uart_tx_stats.bytes += len;
+    uart_tx_stats.transfers++;
+}
+
+/**
+ * @brief Mesajı tampona kopyalar, beklemez - ISR'dan da çağrılabilir
+ * @retval HAL_BUSY: yer yok, mesaj atıldı
+ */
+HAL_StatusTypeDef UartTx_Write(const uint8_t* data, uint16_t len)
+{
+    if (len == 0) return HAL_OK;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t used = head - tail;
+    if (len > UART_TX_BUF_SIZE - used)
+    {
+        uart_tx_stats.dropped_bytes += len;
+        uart_tx_stats.drops++;
+        __set_PRIMASK(primask);
+        return HAL_BUSY;
+    }
+
+    uint32_t pos = head & (UART_TX_BUF_SIZE - 1);
+    uint32_t first = UART_TX_BUF_SIZE - pos;
+    if (first > len) first = len;
+    memcpy(&tx_buf[pos], data, first);
+    memcpy(tx_buf, data + first, len - first);
+    head += len;
+
+    if (used + len > uart_tx_stats.high_water) uart_tx_stats.high_water = (uint16_t)(used + len);
+    UartTx_Kick();
+
+    __set_PRIMASK(primask);
+    return HAL_OK;
+}
+
+/**
+ * @brief Yer açıldıkça parça parça yazar - kaybolmaması gereken ikili veri için
+ *        Ana döngüden; UART hızında bekler
+ * @retval HAL_TIMEOUT: DMA ilerlemedi, kalan veri atıldı
+ */
+HAL_StatusTypeDef UartTx_WriteBlocking(const uint8_t* data, uint16_t len)
+{
+    uint32_t last_progress = HAL_GetTick();
+
+    while (len > 0)
+    {
+        uint32_t space = UART_TX_BUF_SIZE - (head - tail);
+        if (space == 0)
+        {
+            if (HAL_GetTick() - last_progress > UART_TX_BLOCK_TIMEOUT_MS)
+            {
+                __disable_irq();
+                uart_tx_stats.dropped_bytes += len;
+                uart_tx_stats.drops++;
+                __enable_irq();
+                return HAL_TIMEOUT;
+            }
+            continue;
+        }
+
+        uint16_t chunk = (space < len) ? (uint16_t)space : len;
+        UartTx_Write(data, chunk);
+        data += chunk;
+        len -= chunk;
+        last_progress = HAL_GetTick();
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Tampon boşalana kadar bekler (reset/flash silme öncesi)
+ */
+HAL_StatusTypeDef UartTx_Flush(uint32_t timeout_ms)
+{
+    uint32_t start = HAL_GetTick();
+
+    while (head != tail || busy)
+    {
+        if (HAL_GetTick() - start > timeout_ms) return HAL_TIMEOUT;
+    }
+    return HAL_OK;
+}
+
+uint16_t UartTx_Pending(void)
+{
+    return (uint16_t)(head - tail);
+}
+
+/**
+ * @brief DMA hatasında HAL aktarımı bırakır, tamamlanma gelmez - HAL_UART_ErrorCallback'ten
+ *        Süren parça atlanır, sıradaki başlatılır
+ */
+void UartTx_Resume(void)
+{
+    if (!busy || huart2.gState != HAL_UART_STATE_READY) return;
+
+    tail += dma_len;
+    busy = 0;
+    uart_tx_stats.errors++;
+    UartTx_Kick();
+}
+
+/**
+ * @brief DMA parçası bitti - zincirdeki sonrakini başlat
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance != USART2) return;
+
+    tail += dma_len;
+    busy = 0;
+    UartTx_Kick();
+}
+
+void UartTx_Report(void)
+{
+    char msg[160];
+    const UartTx_Stats_t* s = &uart_tx_stats;
+
+    sprintf(msg, "UartTx[Bekleyen:%u/%u Tepe:%u Gönderilen:%lu Aktarım:%lu Atılan:%lu byte/%lu mesaj Hata:%lu]\r\n",
+            UartTx_Pending(), UART_TX_BUF_SIZE, s->high_water, s->bytes, s->transfers,
+            s->dropped_bytes, s->drops, s->errors);
+    SendDebugMessage(msg);
+}
@@ -2,6 +2,8 @@
 #include "main.h"
 
 UART_HandleTypeDef huart2;
+DMA_HandleTypeDef hdma_usart2_rx;
+DMA_HandleTypeDef hdma_usart2_tx;
 
 /* USART2 init function */
 void MX_USART2_UART_Init(void)
@@ -0,0 +1,129 @@
+/* Host testi: SpeedProfile planı + Q32 adımlayıcı, bağımsız kapalı form referansa karşı
+ *
+ *   gcc -std=c11 -O2 -ICore/Inc Core/Src/speed_profile.c Tests/test_speed_profile.c -lm -o test_speed_profile
+ *   ./test_speed_profile
+ *
+ * Plan faz sürelerini tam tick'e yukarı yuvarlar (geçiş başına en fazla 3
+ * faz, seyir yarım tick): aynı andaki fark ivme × 7 tick'i, çıkış tamsayıya
+ * yuvarlandığı için +1 birimi geçmemeli. Ayrıca toplam süre, son değer,
+ * tick başına değişim (ivme sınırı) ve aşım kontrol edilir. */
+
+#include "speed_profile.h"
+#include <math.h>
+#include <stdio.h>
+
+typedef struct {
+    const char* name;
+    SpeedProfile_Params_t p;
+    float tick_hz;
+} Case_t;
+
+static const Case_t cases[] = {
+    { "trapez",            { 0.0f, 3600.0f, 0.0f, 7200.0f, 0.0f, 0.5f }, 20000.0f },
+    { "s-curve tepe ivme", { 0.0f, 3600.0f, 0.0f, 7200.0f, 36000.0f, 0.2f }, 20000.0f },
+    { "s-curve kısa",      { 100.0f, 400.0f, 50.0f, 7200.0f, 36000.0f, 0.0f }, 20000.0f },
+    { "geri yön",          { 1800.0f, -1800.0f, 0.0f, 3600.0f, 18000.0f, 0.1f }, 20000.0f },
+    { "aynı hız",          { 900.0f, 900.0f, 900.0f, 3600.0f, 0.0f, 0.05f }, 20000.0f },
+    { "düşük tick",        { 0.0f, 65535.0f, 0.0f, 100000.0f, 400000.0f, 0.3f }, 1000.0f },
+    { "kesirli süre",      { 0.0f, 1000.0f, 333.0f, 3333.3f, 11111.1f, 0.0123f }, 7919.0f },
+};
+
+static double Case_Duration(const SpeedProfile_Params_t* p)
+{
+    double total = p->cruise_s;
+    const float v[3] = { p->v_start, p->v_peak, p->v_end };
+
+    for (int k = 0; k < 2; k++)
+    {
+        double dv = fabs((double)v[k + 1] - v[k]);
+        if (dv == 0.0) continue;
+        if (p->jerk <= 0.0f) { total += dv / p->accel; continue; }
+        double tj = p->accel / p->jerk;
+        double ta = 0.0;
+        if (dv >= p->accel * tj) ta = dv / p->accel - tj;
+        else tj = sqrt(dv / p->jerk);
+        total += 2.0 * tj + ta;
+    }
+    return total;
+}
+
+static int Case_Run(const Case_t* c)
+{
+    SpeedProfile_Plan_t plan;
+    SpeedProfile_State_t state;
+    const SpeedProfile_Params_t* p = &c->p;
+    int failures = 0;
+
+    if (SpeedProfile_Plan(&plan, p, c->tick_hz) != 0)
+    {
+        printf("FAIL %-18s plan reddedildi\n", c->name);
+        return 1;
+    }
+
+    double bound = p->accel * 7.0 / c->tick_hz + 1.0;
+    double step_bound = p->accel / c->tick_hz + 1.0;
+    double lo = fmin(fmin(p->v_start, p->v_peak), p->v_end) - 1.0;
+    double hi = fmax(fmax(p->v_start, p->v_peak), p->v_end) + 1.0;
+    double ideal_ticks = Case_Duration(p) * c->tick_hz;
+    double max_err = 0.0, max_step = 0.0;
+    int32_t out = 0, prev = (int32_t)lround(p->v_start);
+    uint32_t n = 0;
+
+    SpeedProfile_Begin(&state, &plan);
+    while (SpeedProfile_Step(&state, &out))
+    {
+        n++;
+        double ref = SpeedProfile_Reference(p, (float)n / c->tick_hz);
+        double err = fabs(out - ref);
+        double step = fabs((double)(out - prev));
+        if (err > max_err) max_err = err;
+        if (step > max_step) max_step = step;
+        if (out < lo || out > hi)
+        {
+            printf("FAIL %-18s tick %u: %d aralık dışında [%.1f, %.1f]\n", c->name, n, out, lo, hi);
+            failures++;
+            break;
+        }
+        prev = out;
+    }
+
+    if (n != plan.total_ticks || n < ideal_ticks - 0.5 || n > ideal_ticks + 7.5)
+    {
+        printf("FAIL %-18s süre %u tick, ideal %.1f\n", c->name, n, ideal_ticks);
+        failures++;
+    }
+    if (out != (int32_t)lroundf(p->v_end))
+    {
+        printf("FAIL %-18s son değer %d, beklenen %.0f\n", c->name, out, p->v_end);
+        failures++;
+    }
+    if (max_err > bound)
+    {
+        printf("FAIL %-18s referans hatası %.3f > %.3f\n", c->name, max_err, bound);
+        failures++;
+    }
+    if (max_step > step_bound)
+    {
+        printf("FAIL %-18s tick başına değişim %.3f > %.3f\n", c->name, max_step, step_bound);
+        failures++;
+    }
+
+    if (!failures)
+    {
+        printf("ok   %-18s %u tick (ideal %.1f) hata %.3f/%.3f adım %.3f/%.3f\n",
+               c->name, n, ideal_ticks, max_err, bound, max_step, step_bound);
+    }
+    return failures;
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        failures += Case_Run(&cases[i]);
+    }
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""
+Motor transfer eğrisi tablosu üretici
+Core/Src/motor_curve_table.c dosyasını üretir: varsayılan (derleme anı) eğri,
+gyro büyüklüğünün karesiyle (ham LSB²) indekslenen sabit tablo. Tablo düzeni
+Core/Inc/motor_curve.h ile aynı olmalıdır (MOTOR_CURVE_SIZE, MOTOR_CURVE_SHIFT).
+
+Kullanım: python gen_motor_curve.py [min_dps] [max_dps]
+"""
+
+import math
+import sys
+
+CURVE_SIZE = 1024          # MOTOR_CURVE_SIZE
+CURVE_SHIFT = 11           # MOTOR_CURVE_SHIFT: hücre başına 2048 LSB²
+DUTY_FULL = 10000          # MOTOR_DUTY_FULL
+DPS_PER_LSB = 0.00875      # L3GD20 ±250 dps hassasiyeti
+
+OUTPUT = "Core/Src/motor_curve_table.c"
+
+
+def cell_dps(i):
+    """Hücre ortasındaki büyüklük (dps) - MotorCurve_CellDps ile aynı"""
+    return math.sqrt((i + 0.5) * (1 << CURVE_SHIFT)) * DPS_PER_LSB
+
+
+def linear(mag, min_dps, max_dps):
+    if mag < min_dps:
+        return 0
+    t = min((mag - min_dps) / (max_dps - min_dps), 1.0)
+    return int(round(t * DUTY_FULL))
+
+
+def main():
+    min_dps = float(sys.argv[1]) if len(sys.argv) > 1 else 0.5
+    max_dps = float(sys.argv[2]) if len(sys.argv) > 2 else 10.0
+
+    values = [linear(cell_dps(i), min_dps, max_dps) for i in range(CURVE_SIZE)]
+
+    with open(OUTPUT, "w", newline="\n") as f:
+        f.write("/* gen_motor_curve.py ile üretildi - elle düzenlemeyin */\n")
+        f.write('#include "motor_curve.h"\n\n')
+        f.write("/* Varsayılan eğri: doğrusal, %.2f dps -> 0%%, %.2f dps -> 100%% */\n" % (min_dps, max_dps))
+        f.write("const uint16_t motor_curve_default[MOTOR_CURVE_SIZE] = {\n")
+        for row in range(0, CURVE_SIZE, 16):
+            f.write("    " + ", ".join("%5d" % v for v in values[row:row + 16]) + ",\n")
+        f.write("};\n")
+
+    print("%s yazıldı (%d hücre, %.2f-%.2f dps)" % (OUTPUT, CURVE_SIZE, min_dps, max_dps))
+
+
+if __name__ == "__main__":
+    main()